@@ -0,0 +1,72 @@
+#include "map.hpp"
+#include <iostream>
+#include <cassert>
+#include <string>
+
+// orders keys by a table of ranks the map gets at run time
+class RankCompare {
+public:
+	const int *rank;
+	RankCompare(const int *r = nullptr) : rank(r) {}
+	bool operator () (const int &lhs, const int &rhs) const {
+		return rank[lhs] < rank[rhs];
+	}
+};
+
+const int N = 1000;
+int up[N], down[N];
+
+void tester(void) {
+	for (int i = 0; i < N; ++i) {
+		up[i] = (i * 7919) % N;
+		down[i] = N - up[i];
+	}
+	//	test: constructor with a comparator
+	sjtu::map<int, std::string, RankCompare> map(RankCompare{ up });
+	for (int i = 0; i < N; ++i) {
+		map[i] = std::to_string(i);
+	}
+	assert(map.size() == N);
+	assert(map.key_comp().rank == up);
+	int last = -1;
+	for (auto it = map.begin(); it != map.end(); ++it) {
+		assert(up[it->first] > last);
+		last = up[it->first];
+	}
+	std::cout << last << std::endl;
+	//	test: copy and assignment carry the comparator along
+	sjtu::map<int, std::string, RankCompare> other(RankCompare{ down });
+	other = map;
+	assert(other.key_comp().rank == up && other.size() == N);
+	sjtu::map<int, std::string, RankCompare> reversed(RankCompare{ down });
+	for (int i = 0; i < N; i += 3) {
+		reversed.insert(sjtu::pair<const int, std::string>(i, "x"));
+	}
+	other = reversed;
+	assert(other.key_comp().rank == down && other.size() == reversed.size());
+	sjtu::map<int, std::string, RankCompare> copied(other);
+	last = -1;
+	for (auto it = copied.cbegin(); it != copied.cend(); ++it) {
+		assert(down[it->first] > last);
+		last = down[it->first];
+	}
+	//	test: find and erase go by the stored comparator
+	for (int i = 0; i < N; i += 3) {
+		assert(copied.count(i) == 1);
+		assert(copied.find(i)->second == "x");
+	}
+	for (int i = 1; i < N; i += 3) {
+		assert(copied.count(i) == 0);
+	}
+	for (int i = 0; i < N; i += 6) {
+		copied.erase(copied.find(i));
+	}
+	std::cout << copied.size() << std::endl;
+	//	test: value_comp
+	sjtu::pair<const int, std::string> a(1, "a"), b(2, "b");
+	std::cout << map.value_comp()(a, b) << " " << copied.value_comp()(a, b) << std::endl;
+}
+
+int main(void) {
+	tester();
+}
@@ -32,6 +32,28 @@ namespace sjtu {
     else std::cout << "Not Assignable" << std::endl;
   }
 
+  /**
+   * the Compare of a map; as a base when it is empty, e.g. std::less.
+   */
+  template<class Compare, bool Empty = std::is_empty<Compare>::value && !std::is_final<Compare>::value>
+  class CompareHolder : private Compare {
+  public:
+    explicit CompareHolder(const Compare& c) : Compare(c) {}
+    const Compare& comp() const {
+      return *this;
+    }
+  };
+  template<class Compare>
+  class CompareHolder<Compare, false> {
+  private:
+    Compare c;
+  public:
+    explicit CompareHolder(const Compare& _c) : c(_c) {}
+    const Compare& comp() const {
+      return c;
+    }
+  };
+
   template<
     class Key,
     class T,
@@ -71,15 +93,16 @@ namespace sjtu {
       }
     };
 
-    class RedBlackTree {
+    class RedBlackTree : public CompareHolder<Compare> {
     public:
+      using CompareHolder<Compare>::comp;
 
       node* root;
       node* nullNode;
       int siz;
 
     public:
-      RedBlackTree() {
+      explicit RedBlackTree(const Compare& c = Compare()) : CompareHolder<Compare>(c) {
         nullNode = new node;
         nullNode->c[0] = nullNode->c[1] = nullNode->fa = nullNode;
         nullNode->col = 0; siz = 0;
@@ -103,7 +126,7 @@ namespace sjtu {
         copy(x->c[1], other->c[1], other_nullNode);
         if (x->c[1] != nullNode) x->c[1]->fa = x;
       }
-      RedBlackTree(const RedBlackTree& other) {
+      RedBlackTree(const RedBlackTree& other) : CompareHolder<Compare>(other) {
         nullNode = new node;
         nullNode->c[0] = nullNode->c[1] = nullNode->fa = nullNode;
         nullNode->col = 0; siz = other.siz;
@@ -113,6 +136,8 @@ namespace sjtu {
       RedBlackTree& operator =(const RedBlackTree& other) {
         if (this == &other) return (*this);
         clear(root); siz = other.siz;
+        root = nullNode;
+        CompareHolder<Compare>::operator=(other);
         copy(root, other.root, other.nullNode);
         return (*this);
       }
@@ -183,10 +208,10 @@ namespace sjtu {
         node* x = root, * f = nullNode;
         while (x != nullNode) {
           f = x;
-          x = x->c[Compare()((*(x->val)).first, v.first)];
+          x = x->c[comp()((*(x->val)).first, v.first)];
         }
         x = new node(v.first, v.second, nullNode); siz++;
-        if (f != nullNode) f->c[Compare()((*(f->val)).first, v.first)] = x;
+        if (f != nullNode) f->c[comp()((*(f->val)).first, v.first)] = x;
         else root = x;
         x->fa = f; ins_fix(x);
         return x;
@@ -223,8 +248,8 @@ namespace sjtu {
       }
       bool del(const value_type& v) {
         node* x = root;
-        while (x != nullNode && (Compare()((*(x->val)).first, v.first) || Compare()(v.first, (*(x->val)).first)))
-          x = x->c[Compare()((*(x->val)).first, v.first)];
+        while (x != nullNode && (comp()((*(x->val)).first, v.first) || comp()(v.first, (*(x->val)).first)))
+          x = x->c[comp()((*(x->val)).first, v.first)];
         if (x == nullNode) return false;
         node* ex = x, * g = nullptr;
         if (x->c[0] != nullNode && x->c[1] != nullNode) {
@@ -276,8 +301,8 @@ namespace sjtu {
       }
       node* find(const Key& key)const {
         node* x = root;
-        while (x != nullNode && (Compare()((*(x->val)).first, key) || Compare()(key, (*(x->val)).first)))
-          x = x->c[Compare()((*(x->val)).first, key)];
+        while (x != nullNode && (comp()((*(x->val)).first, key) || comp()(key, (*(x->val)).first)))
+          x = x->c[comp()((*(x->val)).first, key)];
         return x;
       }
     };
@@ -446,10 +471,26 @@ namespace sjtu {
         return pos->val;
       }
     };
+    typedef Compare key_compare;
+    /**
+     * orders value_type by key, with the comparator of the map.
+     */
+    class value_compare {
+      friend class map;
+    protected:
+      Compare comp;
+      value_compare(const Compare& c) : comp(c) {}
+    public:
+      bool operator()(const value_type& lhs, const value_type& rhs) const {
+        return comp(lhs.first, rhs.first);
+      }
+    };
     /**
      * TODO two constructors
+     * the map keeps a copy of comp and orders its keys with it.
      */
     map() {}
+    explicit map(const Compare& comp) :RBT(comp) {}
     map(const map& other) :RBT(other.RBT) {}
     /**
      * TODO assignment operator
@@ -459,6 +500,16 @@ namespace sjtu {
       RBT = other.RBT;
       return (*this);
     }
+    /**
+     * the comparator the keys are ordered with, and the same ordering
+     * on value_type.
+     */
+    key_compare key_comp() const {
+      return RBT.comp();
+    }
+    value_compare value_comp() const {
+      return value_compare(RBT.comp());
+    }
     /**
      * TODO Destructors
      */
@@ -0,0 +1,102 @@
+// a comparator with state: ids ranked through a table known only at run
+// time. the queue holding a pointer to the table in its Compare, against
+// the old way round, a stateless Compare reading a global, and against
+// comparing the ranks directly with std::less.
+// usage: comparator_bench [n] [rounds] [ids]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "priority_queue.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+static int *table;
+
+struct RankLess {
+	const int *rank;
+	RankLess(const int *r = nullptr) : rank(r) {}
+	bool operator()(int a, int b) const {
+		return rank[a] < rank[b];
+	}
+};
+struct GlobalRankLess {
+	bool operator()(int a, int b) const {
+		return table[a] < table[b];
+	}
+};
+
+typedef sjtu::priority_queue<int> Direct;
+typedef sjtu::priority_queue<int, RankLess> Stateful;
+typedef sjtu::priority_queue<int, GlobalRankLess> Global;
+
+Direct makeQueue(Direct *) {
+	return Direct();
+}
+Stateful makeQueue(Stateful *) {
+	return Stateful(RankLess(table));
+}
+Global makeQueue(Global *) {
+	return Global();
+}
+
+// what goes into the queue: the rank itself for Direct, the id otherwise
+int elem(Direct *, int id) {
+	return table[id];
+}
+template<class Queue>
+int elem(Queue *, int id) {
+	return id;
+}
+
+template<class Queue>
+void run(const char *name, int n, int rounds, int ids) {
+	typedef std::chrono::steady_clock clock;
+	Queue *tag = nullptr;
+	long long checksum = 0;
+	double pushSec = 0, mixedSec = 0, popSec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		Queue q(makeQueue(tag));
+		seed = 19260817 + r;
+		auto t0 = clock::now();
+		for (int i = 0; i < n; ++i) q.push(elem(tag, (int)(nextRand() % ids)));
+		auto t1 = clock::now();
+		for (int i = 0; i < n; ++i) {
+			checksum += q.top();
+			q.pop();
+			q.push(elem(tag, (int)(nextRand() % ids)));
+		}
+		auto t2 = clock::now();
+		while (!q.empty()) {
+			checksum += q.top();
+			q.pop();
+		}
+		auto t3 = clock::now();
+		pushSec += std::chrono::duration<double>(t1 - t0).count();
+		mixedSec += std::chrono::duration<double>(t2 - t1).count();
+		popSec += std::chrono::duration<double>(t3 - t2).count();
+	}
+	double ops = 1.0 * n * rounds;
+	printf("%-16s queue %2zu B  push %8.2f  pop+push %8.2f  pop %8.2f ns/op  (checksum %lld)\n",
+		name, sizeof(Queue), pushSec * 1e9 / ops, mixedSec * 1e9 / ops,
+		popSec * 1e9 / ops, checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	int ids = argc > 3 ? atoi(argv[3]) : 4096;
+	table = new int[ids];
+	for (int i = 0; i < ids; ++i) table[i] = (int)(nextRand() % 1000000);
+	run<Direct>("std::less rank", n, rounds, ids);
+	run<Stateful>("stored Compare", n, rounds, ids);
+	run<Global>("global table", n, rounds, ids);
+	delete[] table;
+	return 0;
+}
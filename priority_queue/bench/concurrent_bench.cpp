@@ -0,0 +1,97 @@
+// scalability of concurrent_priority_queue against one mutex-protected
+// priority_queue, and the rank error the relaxation costs.
+// usage: concurrent_bench [max threads] [ops per thread]
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "concurrent_priority_queue.hpp"
+
+unsigned nextRand(unsigned &s) {
+	s ^= s << 13;
+	s ^= s >> 17;
+	s ^= s << 5;
+	return s;
+}
+
+class locked_queue {
+	std::mutex m;
+	sjtu::priority_queue<int> q;
+public:
+	explicit locked_queue(size_t) {}
+	void push(int x) {
+		std::lock_guard<std::mutex> g(m);
+		q.push(x);
+	}
+	bool try_pop(int &x) {
+		std::lock_guard<std::mutex> g(m);
+		if (q.empty()) return false;
+		x = q.pop_value();
+		return true;
+	}
+};
+
+// every thread alternates push and pop on a queue prefilled with 1M keys
+template<class Queue>
+double throughput(int threads, int ops) {
+	Queue q(threads);
+	unsigned seed = 1;
+	for (int i = 0; i < 1000000; ++i) q.push((int)nextRand(seed));
+	std::vector<std::thread> pool;
+	auto start = std::chrono::steady_clock::now();
+	for (int t = 0; t < threads; ++t)
+		pool.emplace_back([&q, ops, t]() {
+			unsigned s = 12345 + t;
+			int x;
+			for (int i = 0; i < ops; ++i) {
+				q.push((int)nextRand(s));
+				q.try_pop(x);
+			}
+		});
+	for (auto &th : pool) th.join();
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return 2.0 * threads * ops / sec / 1e6;
+}
+
+// threads drain n distinct keys; the rank error of a pop is the number of
+// better keys that were popped after it, averaged over all pops
+double rankError(int threads, int n) {
+	sjtu::concurrent_priority_queue<int> q(threads);
+	for (int i = 0; i < n; ++i) q.push(i);
+	std::vector<int> order(n);
+	std::atomic<int> ticket(0);
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t)
+		pool.emplace_back([&]() {
+			int x;
+			while (q.try_pop(x)) order[ticket++] = x;
+		});
+	for (auto &th : pool) th.join();
+	// inversions: for each pop, count later pops with a larger key
+	std::vector<int> bit(n + 1, 0);
+	long long inv = 0;
+	for (int i = ticket - 1; i >= 0; --i) {
+		for (int k = n; k > 0; k -= k & -k) inv += bit[k];
+		for (int k = order[i] + 1; k > 0; k -= k & -k) inv -= bit[k];
+		for (int k = order[i] + 1; k <= n; k += k & -k) ++bit[k];
+	}
+	return (double)inv / ticket;
+}
+
+int main(int argc, char *argv[]) {
+	int maxThreads = argc > 1 ? atoi(argv[1]) : 64;
+	int ops = argc > 2 ? atoi(argv[2]) : 1000000;
+	printf("%8s %22s %22s %14s\n", "threads", "mutex queue (Mops/s)", "multiqueue (Mops/s)", "rank error");
+	for (int t = 1; t <= maxThreads; t *= 2) {
+		double locked = throughput<locked_queue>(t, ops / t);
+		double multi = throughput<sjtu::concurrent_priority_queue<int>>(t, ops / t);
+		printf("%8d %22.2f %22.2f %14.2f\n", t, locked, multi, rankError(t, 1000000));
+	}
+	return 0;
+}
@@ -0,0 +1,133 @@
+// dijkstra on a random graph: lazy deletion on the leftist priority_queue
+// (push duplicates, skip stale entries) against decrease-key on the
+// addressable pairing_heap.
+// usage: dijkstra_bench [vertices] [edges]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "pairing_heap.hpp"
+
+struct Entry {
+	long long d;
+	int v;
+	Entry(long long _d = 0, int _v = 0) : d(_d), v(_v) {}
+};
+// the nearest vertex is on top
+struct Farther {
+	bool operator()(const Entry &a, const Entry &b) const {
+		return a.d > b.d;
+	}
+};
+
+int n, m;
+std::vector<int> head, to, weight;
+
+static unsigned long long seed = 88172645463325252ull;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return (unsigned)seed;
+}
+
+void buildGraph() {
+	std::vector<int> from(m);
+	head.assign(n + 1, 0);
+	to.resize(m); weight.resize(m);
+	for (int i = 0; i < m; ++i) {
+		from[i] = i < n - 1 ? i : nextRand() % n;  // a path keeps it connected
+		++head[from[i] + 1];
+	}
+	for (int i = 0; i < n; ++i) head[i + 1] += head[i];
+	std::vector<int> pos(head.begin(), head.end() - 1);
+	for (int i = 0; i < m; ++i) {
+		int e = pos[from[i]]++;
+		to[e] = i < n - 1 ? i + 1 : nextRand() % n;
+		weight[e] = nextRand() % 1000000 + 1;
+	}
+}
+
+long long lazyDijkstra(size_t &maxSize, long long &pushes) {
+	std::vector<long long> dist(n, -1);
+	std::vector<char> done(n, 0);
+	sjtu::priority_queue<Entry, Farther> q;
+	dist[0] = 0;
+	q.push(Entry(0, 0));
+	pushes = 1; maxSize = 1;
+	while (!q.empty()) {
+		Entry x = q.top();
+		q.pop();
+		if (done[x.v]) continue;
+		done[x.v] = 1;
+		for (int e = head[x.v]; e < head[x.v + 1]; ++e) {
+			long long nd = x.d + weight[e];
+			if (dist[to[e]] < 0 || nd < dist[to[e]]) {
+				dist[to[e]] = nd;
+				q.push(Entry(nd, to[e]));
+				++pushes;
+				if (q.size() > maxSize) maxSize = q.size();
+			}
+		}
+	}
+	long long sum = 0;
+	for (int i = 0; i < n; ++i) sum += dist[i];
+	return sum;
+}
+
+long long handleDijkstra(size_t &maxSize, long long &pushes) {
+	typedef sjtu::pairing_heap<Entry, Farther> heap;
+	std::vector<long long> dist(n, -1);
+	std::vector<heap::handle> h(n);
+	std::vector<char> inQueue(n, 0);
+	heap q;
+	dist[0] = 0;
+	h[0] = q.push(Entry(0, 0));
+	inQueue[0] = 1;
+	pushes = 1; maxSize = 1;
+	while (!q.empty()) {
+		Entry x = q.top();
+		q.pop();
+		inQueue[x.v] = 0;
+		for (int e = head[x.v]; e < head[x.v + 1]; ++e) {
+			int y = to[e];
+			long long nd = x.d + weight[e];
+			if (dist[y] < 0) {
+				dist[y] = nd;
+				h[y] = q.push(Entry(nd, y));
+				inQueue[y] = 1;
+				++pushes;
+				if (q.size() > maxSize) maxSize = q.size();
+			} else if (nd < dist[y] && inQueue[y]) {
+				dist[y] = nd;
+				// under Farther a shorter distance compares greater: an increase
+				q.increase_key(h[y], Entry(nd, y));
+			}
+		}
+	}
+	long long sum = 0;
+	for (int i = 0; i < n; ++i) sum += dist[i];
+	return sum;
+}
+
+template<class F>
+void run(const char *name, F f) {
+	size_t maxSize;
+	long long pushes;
+	auto start = std::chrono::steady_clock::now();
+	long long sum = f(maxSize, pushes);
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-32s %8.3f s  pushes %10lld  max size %10zu  (checksum %lld)\n", name, sec, pushes, maxSize, sum);
+}
+
+int main(int argc, char *argv[]) {
+	n = argc > 1 ? atoi(argv[1]) : 1000000;
+	m = argc > 2 ? atoi(argv[2]) : 10000000;
+	buildGraph();
+	printf("n = %d, m = %d\n", n, m);
+	run("leftist, lazy deletion", lazyDijkstra);
+	run("pairing_heap, decrease-key", handleDijkstra);
+	return 0;
+}
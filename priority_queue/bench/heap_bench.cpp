@@ -0,0 +1,85 @@
+// push/pop throughput of the leftist priority_queue against the other heaps.
+// usage: heap_bench [n] [rounds]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+#include "pairing_heap.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+template<class Queue>
+void run(const char *name, int n, int rounds) {
+	typedef std::chrono::steady_clock clock;
+	long long checksum = 0;
+	double pushSec = 0, mixedSec = 0, popSec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		Queue q;
+		seed = 19260817 + r;
+		auto t0 = clock::now();
+		for (int i = 0; i < n; ++i) q.push((int)nextRand());
+		auto t1 = clock::now();
+		// steady state: one pop and one push per step
+		for (int i = 0; i < n; ++i) {
+			checksum += q.top();
+			q.pop();
+			q.push((int)nextRand());
+		}
+		auto t2 = clock::now();
+		while (!q.empty()) {
+			checksum += q.top();
+			q.pop();
+		}
+		auto t3 = clock::now();
+		pushSec += std::chrono::duration<double>(t1 - t0).count();
+		mixedSec += std::chrono::duration<double>(t2 - t1).count();
+		popSec += std::chrono::duration<double>(t3 - t2).count();
+	}
+	double ops = 1.0 * n * rounds;
+	printf("%-24s push %8.2f  pop+push %8.2f  pop %8.2f ns/op  (checksum %lld)\n", name,
+		pushSec * 1e9 / ops, mixedSec * 1e9 / ops, popSec * 1e9 / ops, checksum);
+}
+
+// n pushes against one range construction
+template<class Queue>
+void build(const char *name, int n) {
+	typedef std::chrono::steady_clock clock;
+	std::vector<int> v(n);
+	seed = 19260817;
+	for (int i = 0; i < n; ++i) v[i] = (int)nextRand();
+	auto t0 = clock::now();
+	{
+		Queue q;
+		for (int i = 0; i < n; ++i) q.push(v[i]);
+	}
+	auto t1 = clock::now();
+	{
+		Queue q(v.begin(), v.end());
+	}
+	auto t2 = clock::now();
+	printf("%-24s push loop %8.3f s  range %8.3f s\n", name,
+		std::chrono::duration<double>(t1 - t0).count(), std::chrono::duration<double>(t2 - t1).count());
+}
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	printf("n = %d, rounds = %d\n", n, rounds);
+	run<sjtu::priority_queue<int>>("leftist priority_queue", n, rounds);
+	run<sjtu::pairing_heap<int>>("pairing_heap", n, rounds);
+	run<sjtu::dary_heap<int, std::less<int>, 2>>("dary_heap<2>", n, rounds);
+	run<sjtu::dary_heap<int, std::less<int>, 4>>("dary_heap<4>", n, rounds);
+	run<sjtu::dary_heap<int, std::less<int>, 8>>("dary_heap<8>", n, rounds);
+	build<sjtu::priority_queue<int>>("leftist priority_queue", n * 10);
+	build<sjtu::dary_heap<int>>("dary_heap<4>", n * 10);
+	return 0;
+}
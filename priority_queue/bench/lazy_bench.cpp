@@ -0,0 +1,61 @@
+// bursty merges: every round, k small priority_queues are filled and
+// merged into one big queue, and then only a few elements are popped.
+// the big queue is a priority_queue merging eagerly, or a
+// lazy_priority_queue.
+// usage: lazy_bench [rounds] [queues per round] [per queue] [pops per round]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "lazy_priority_queue.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+template<class Queue>
+void run(const char *name, int rounds, int k, int s, int pops) {
+	typedef std::chrono::steady_clock clock;
+	seed = 19260817;
+	Queue big;
+	long long checksum = 0;
+	double pushSec = 0, mergeSec = 0, popSec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		std::vector<sjtu::priority_queue<int>> small(k);
+		auto t0 = clock::now();
+		for (auto &q : small)
+			for (int i = 0; i < s; ++i) q.push((int)(nextRand() >> 1));
+		auto t1 = clock::now();
+		for (auto &q : small) big.merge(q);
+		auto t2 = clock::now();
+		for (int i = 0; i < pops; ++i) {
+			checksum += big.top();
+			big.pop();
+		}
+		auto t3 = clock::now();
+		pushSec += std::chrono::duration<double>(t1 - t0).count();
+		mergeSec += std::chrono::duration<double>(t2 - t1).count();
+		popSec += std::chrono::duration<double>(t3 - t2).count();
+	}
+	printf("%-8s push %8.2f ms  merge %8.2f ms  pop %8.2f ms  total %8.2f ms  size %zu  (checksum %lld)\n",
+		name, pushSec * 1e3, mergeSec * 1e3, popSec * 1e3,
+		(pushSec + mergeSec + popSec) * 1e3, big.size(), checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int rounds = argc > 1 ? atoi(argv[1]) : 200;
+	int k = argc > 2 ? atoi(argv[2]) : 1000;
+	int s = argc > 3 ? atoi(argv[3]) : 8;
+	int pops = argc > 4 ? atoi(argv[4]) : 4;
+	// the first run also pays for faulting in fresh memory
+	run<sjtu::priority_queue<int>>("warm-up", rounds, k, s, pops);
+	run<sjtu::priority_queue<int>>("eager", rounds, k, s, pops);
+	run<sjtu::lazy_priority_queue<int>>("lazy", rounds, k, s, pops);
+	return 0;
+}
@@ -0,0 +1,53 @@
+// consolidating k shards: k - 1 merges into one queue against merge_all.
+// usage: merge_bench [shards] [per shard]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+typedef sjtu::priority_queue<int> Queue;
+
+void fill(std::vector<Queue> &shards, int n) {
+	seed = 19260817;
+	for (auto &q : shards)
+		for (int i = 0; i < n; ++i) q.push((int)nextRand());
+}
+
+template<class Merge>
+void run(const char *name, int k, int n, Merge merge) {
+	typedef std::chrono::steady_clock clock;
+	std::vector<Queue> shards(k);
+	fill(shards, n);
+	auto t0 = clock::now();
+	merge(shards);
+	auto t1 = clock::now();
+	long long checksum = 0;
+	for (int i = 0; i < 1000 && !shards[0].empty(); ++i) {
+		checksum += shards[0].top();
+		shards[0].pop();
+	}
+	printf("%-12s %10.2f us  size %zu  (checksum %lld)\n", name,
+		std::chrono::duration<double>(t1 - t0).count() * 1e6, shards[0].size(), checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int k = argc > 1 ? atoi(argv[1]) : 64;
+	int n = argc > 2 ? atoi(argv[2]) : 1000000;
+	run("sequential", k, n, [](std::vector<Queue> &s) {
+		for (size_t i = 1; i < s.size(); ++i) s[0].merge(s[i]);
+	});
+	run("merge_all", k, n, [](std::vector<Queue> &s) {
+		s[0].merge_all(s.begin() + 1, s.end());
+	});
+	return 0;
+}
@@ -0,0 +1,90 @@
+// the iterative mergeNode of priority_queue against the recursive merge it
+// replaced, on the same queue and the same node pool.
+// usage: merge_path_bench [n] [rounds]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <utility>
+
+#include "priority_queue.hpp"
+
+typedef sjtu::priority_queue<int> Queue;
+typedef sjtu::Node<int> Node;
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+// the previous mergeNode, verbatim
+Node* recursiveMerge(Node* x, Node* y) {
+	if (!x) return y;
+	if (!y) return x;
+	if (std::less<int>()(x->val, y->val)) std::swap(x, y);
+	x->rc = recursiveMerge(x->rc, y);
+	if (!x->lc) {
+		x->dis = 0; std::swap(x->rc, x->lc);
+		return x;
+	}
+	if (x->rc->dis > x->lc->dis) std::swap(x->rc, x->lc);
+	x->dis = x->rc->dis + 1;
+	return x;
+}
+
+struct Iterative {
+	static Node* merge(Queue& q, Node* x, Node* y) {
+		return q.mergeNode(x, y);
+	}
+};
+struct Recursive {
+	static Node* merge(Queue&, Node* x, Node* y) {
+		return recursiveMerge(x, y);
+	}
+};
+
+template<class Merge>
+void run(const char *name, int n, int rounds) {
+	typedef std::chrono::steady_clock clock;
+	long long checksum = 0;
+	double pushSec = 0, mixedSec = 0, popSec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		Queue q;
+		seed = 19260817 + r;
+		auto t0 = clock::now();
+		for (int i = 0; i < n; ++i) q.root = Merge::merge(q, q.root, q.newNode((int)nextRand()));
+		auto t1 = clock::now();
+		for (int i = 0; i < n; ++i) {
+			Node* x = q.root;
+			checksum += x->val;
+			q.root = Merge::merge(q, x->lc, x->rc);
+			q.freeNode(x);
+			q.root = Merge::merge(q, q.root, q.newNode((int)nextRand()));
+		}
+		auto t2 = clock::now();
+		while (q.root) {
+			Node* x = q.root;
+			checksum += x->val;
+			q.root = Merge::merge(q, x->lc, x->rc);
+			q.freeNode(x);
+		}
+		auto t3 = clock::now();
+		pushSec += std::chrono::duration<double>(t1 - t0).count();
+		mixedSec += std::chrono::duration<double>(t2 - t1).count();
+		popSec += std::chrono::duration<double>(t3 - t2).count();
+	}
+	double ops = 1.0 * n * rounds;
+	printf("%-10s push %8.2f  pop+push %8.2f  pop %8.2f ns/op  (checksum %lld)\n", name,
+		pushSec * 1e9 / ops, mixedSec * 1e9 / ops, popSec * 1e9 / ops, checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	run<Recursive>("recursive", n, rounds);
+	run<Iterative>("iterative", n, rounds);
+	return 0;
+}
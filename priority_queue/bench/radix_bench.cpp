@@ -0,0 +1,73 @@
+// monotone workload (pop the earliest event, schedule a later one):
+// radix_heap against the comparison heaps.
+// usage: radix_bench [pending] [steps]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+#include "radix_heap.hpp"
+
+struct Event {
+	unsigned long long t;
+	int id;
+	Event(unsigned long long _t = 0, int _id = 0) : t(_t), id(_id) {}
+};
+struct Later {
+	bool operator()(const Event &a, const Event &b) const {
+		return a.t > b.t;
+	}
+};
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+template<class Queue>
+void runHeap(const char *name, int pending, int steps) {
+	seed = 19260817;
+	long long checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	Queue q;
+	for (int i = 0; i < pending; ++i) q.push(Event(nextRand() % 1000000, i));
+	for (int i = 0; i < steps; ++i) {
+		Event e = q.top();
+		q.pop();
+		checksum += e.t;
+		q.push(Event(e.t + nextRand() % 1000000, e.id));
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-24s %8.2f ns/step  (checksum %lld)\n", name, sec * 1e9 / (pending + steps), checksum);
+}
+
+void runRadix(int pending, int steps) {
+	seed = 19260817;
+	long long checksum = 0;
+	auto start = std::chrono::steady_clock::now();
+	sjtu::radix_heap<unsigned long long, int> q;
+	for (int i = 0; i < pending; ++i) q.push(nextRand() % 1000000, i);
+	for (int i = 0; i < steps; ++i) {
+		unsigned long long t = q.top().first;
+		int id = q.top().second;
+		q.pop();
+		checksum += t;
+		q.push(t + nextRand() % 1000000, id);
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-24s %8.2f ns/step  (checksum %lld)\n", "radix_heap", sec * 1e9 / (pending + steps), checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int pending = argc > 1 ? atoi(argv[1]) : 1000000;
+	int steps = argc > 2 ? atoi(argv[2]) : 10000000;
+	printf("pending = %d, steps = %d\n", pending, steps);
+	runHeap<sjtu::priority_queue<Event, Later>>("leftist priority_queue", pending, steps);
+	runHeap<sjtu::dary_heap<Event, Later>>("dary_heap<4>", pending, steps);
+	runRadix(pending, steps);
+	return 0;
+}
@@ -0,0 +1,63 @@
+// hold model with a million concurrent events: every event, when it runs,
+// schedules its successor a random delay later, and every fourth one
+// also cancels a random pending event and schedules a replacement.
+// usage: sim_bench [events] [runs]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "simulation.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+const unsigned long long maxDelay = 10000;
+
+// the callback captures one pointer, which std::function stores inline
+template<class Events>
+struct Model {
+	typedef sjtu::event_simulation<Events> Sim;
+	Sim sim;
+	std::vector<typename Sim::event_id> ids;
+	long long ran = 0, cancelled = 0;
+	void add(unsigned long long at) {
+		Model *m = this;
+		ids[nextRand() % ids.size()] = sim.schedule(at, [m]() { m->hold(); });
+	}
+	void hold() {
+		++ran;
+		add(sim.now() + 1 + nextRand() % maxDelay);
+		if (nextRand() % 4 == 0) {
+			if (sim.cancel(ids[nextRand() % ids.size()])) ++cancelled;
+			add(sim.now() + 1 + nextRand() % maxDelay);
+		}
+	}
+};
+
+template<class Events>
+void run(const char *name, int events, long long runs) {
+	seed = 19260817;
+	Model<Events> m;
+	m.ids.resize(events);
+	for (int i = 0; i < events; ++i) m.add(nextRand() % maxDelay);
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned long long t = 0; m.ran < runs; t += 100) m.sim.run_until(t);
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-16s %8.1f ns/event  ran %lld  cancelled %lld  pending %zu\n", name,
+		sec * 1e9 / m.ran, m.ran, m.cancelled, m.sim.size());
+}
+
+int main(int argc, char *argv[]) {
+	int events = argc > 1 ? atoi(argv[1]) : 1000000;
+	long long runs = argc > 2 ? atoll(argv[2]) : 5000000;
+	run<sjtu::leftist_events>("leftist (lazy)", events, runs);
+	run<sjtu::pairing_events>("pairing_heap", events, runs);
+	run<sjtu::wheel_events>("timer_wheel", events, runs);
+	return 0;
+}
@@ -0,0 +1,55 @@
+// cold start of a large queue: pushing every element again against
+// loading a snapshot written by save().
+// usage: snapshot_bench [n] [file]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+double since(std::chrono::steady_clock::time_point t) {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+}
+
+template<class Queue>
+void run(const char *name, int n, const char *file) {
+	auto t0 = std::chrono::steady_clock::now();
+	double saveSec;
+	{
+		Queue q;
+		seed = 19260817;
+		for (int i = 0; i < n; ++i) q.push((int)nextRand());
+		double pushSec = since(t0);
+		printf("%-16s push %8.3f s", name, pushSec);
+		auto t1 = std::chrono::steady_clock::now();
+		std::ofstream os(file, std::ios::binary);
+		q.save(os);
+		os.close();
+		saveSec = since(t1);
+	}
+	auto t2 = std::chrono::steady_clock::now();
+	Queue r;
+	std::ifstream is(file, std::ios::binary);
+	r.load(is);
+	double loadSec = since(t2);
+	printf("  save %8.3f s  load %8.3f s  (top %d, size %zu)\n", saveSec, loadSec, r.top(), r.size());
+}
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 20000000;
+	const char *file = argc > 2 ? argv[2] : "snapshot_bench.bin";
+	run<sjtu::priority_queue<int>>("priority_queue", n, file);
+	run<sjtu::dary_heap<int>>("dary_heap", n, file);
+	std::remove(file);
+	return 0;
+}
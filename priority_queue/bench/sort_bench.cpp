@@ -0,0 +1,49 @@
+// an ordered snapshot of a queue: copy and pop to empty, against
+// to_sorted_vector and drain_sorted.
+// usage: sort_bench [n]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+typedef sjtu::priority_queue<int> Queue;
+
+template<class Snapshot>
+void run(const char *name, int n, Snapshot snapshot) {
+	Queue q;
+	seed = 19260817;
+	for (int i = 0; i < n; ++i) q.push((int)nextRand());
+	std::vector<int> out;
+	out.reserve(n);
+	auto start = std::chrono::steady_clock::now();
+	snapshot(q, out);
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	long long checksum = 0;
+	for (size_t i = 0; i < out.size(); i += 1000) checksum += out[i];
+	printf("%-18s %8.3f s  %zu elements  (checksum %lld)\n", name, sec, out.size(), checksum);
+}
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 10000000;
+	run("copy and pop", n, [](Queue &q, std::vector<int> &out) {
+		Queue c(q);
+		while (!c.empty()) out.push_back(c.pop_value());
+	});
+	run("to_sorted_vector", n, [](Queue &q, std::vector<int> &out) {
+		q.to_sorted_vector(out);
+	});
+	run("drain_sorted", n, [](Queue &q, std::vector<int> &out) {
+		q.drain_sorted(out);
+	});
+	return 0;
+}
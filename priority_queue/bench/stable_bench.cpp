@@ -0,0 +1,87 @@
+// FIFO among equal priorities: the built-in stable mode against wrapping
+// each element with a sequence number and a tie-breaking Compare.
+// priorities come from a small range, so ties are common.
+// usage: stable_bench [n] [rounds] [distinct priorities]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "priority_queue.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+struct Wrapped {
+	int prio;
+	unsigned long long seq;
+	Wrapped(int p = 0, unsigned long long s = 0) : prio(p), seq(s) {}
+	operator int() const {
+		return prio;
+	}
+};
+struct WrappedLess {
+	bool operator()(const Wrapped &a, const Wrapped &b) const {
+		return a.prio < b.prio || (a.prio == b.prio && a.seq > b.seq);
+	}
+};
+
+typedef sjtu::priority_queue<int> Plain;
+typedef sjtu::priority_queue<int, std::less<int>, true> Stable;
+typedef sjtu::priority_queue<Wrapped, WrappedLess> Wrapper;
+
+template<class Queue, class Elem>
+void run(const char *name, int n, int rounds, int distinct) {
+	typedef std::chrono::steady_clock clock;
+	long long checksum = 0;
+	unsigned long long seq = 0;
+	double pushSec = 0, mixedSec = 0, popSec = 0;
+	for (int r = 0; r < rounds; ++r) {
+		Queue q;
+		seed = 19260817 + r;
+		auto t0 = clock::now();
+		for (int i = 0; i < n; ++i) q.push(Elem((int)(nextRand() % distinct), seq++));
+		auto t1 = clock::now();
+		for (int i = 0; i < n; ++i) {
+			checksum += (int)q.top();
+			q.pop();
+			q.push(Elem((int)(nextRand() % distinct), seq++));
+		}
+		auto t2 = clock::now();
+		while (!q.empty()) {
+			checksum += (int)q.top();
+			q.pop();
+		}
+		auto t3 = clock::now();
+		pushSec += std::chrono::duration<double>(t1 - t0).count();
+		mixedSec += std::chrono::duration<double>(t2 - t1).count();
+		popSec += std::chrono::duration<double>(t3 - t2).count();
+	}
+	double ops = 1.0 * n * rounds;
+	printf("%-16s node %2zu B  push %8.2f  pop+push %8.2f  pop %8.2f ns/op  (checksum %lld)\n",
+		name, sizeof(typename Queue::Node), pushSec * 1e9 / ops, mixedSec * 1e9 / ops,
+		popSec * 1e9 / ops, checksum);
+}
+
+// an int built from (priority, sequence) that drops the sequence
+struct PlainElem {
+	int v;
+	PlainElem(int p, unsigned long long) : v(p) {}
+	operator int() const {
+		return v;
+	}
+};
+
+int main(int argc, char *argv[]) {
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+	int rounds = argc > 2 ? atoi(argv[2]) : 3;
+	int distinct = argc > 3 ? atoi(argv[3]) : 1000;
+	run<Plain, PlainElem>("unstable", n, rounds, distinct);
+	run<Stable, PlainElem>("stable mode", n, rounds, distinct);
+	run<Wrapper, Wrapped>("seq wrapper", n, rounds, distinct);
+	return 0;
+}
@@ -0,0 +1,144 @@
+// timeouts that are mostly cancelled before they fire: timer_wheel against
+// priority_queue with lazy deletion (cancelled ids are skipped on pop).
+// every step arms one timeout, cancels a random pending one with
+// probability 9/10 and moves the clock forward by one tick.
+// the last case arms the pending timeouts within 4096 ticks of each other,
+// so they share one slot, and cancels them in deadline order, peeking at
+// the next one after each cancel.
+// usage: timer_bench [pending] [steps]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "timer_wheel.hpp"
+
+static unsigned seed = 19260817;
+unsigned nextRand() {
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+const unsigned long long horizon = 30000;
+
+struct Timeout {
+	unsigned long long t;
+	int id;
+	Timeout(unsigned long long _t = 0, int _id = 0) : t(_t), id(_id) {}
+};
+struct Later {
+	bool operator()(const Timeout &a, const Timeout &b) const {
+		return a.t > b.t;
+	}
+};
+
+void runWheel(int pending, int steps) {
+	typedef sjtu::timer_wheel<int> Wheel;
+	seed = 19260817;
+	Wheel w;
+	std::vector<Wheel::handle> live;
+	std::vector<int> where;  // id -> index in live, -1 once gone
+	long long fired = 0;
+	auto arm = [&](int id) {
+		where.push_back((int)live.size());
+		live.push_back(w.schedule(w.now() + 1 + nextRand() % horizon, id));
+	};
+	auto drop = [&](int id) {
+		int k = where[id];
+		where[(*live.back()).second] = k;
+		live[k] = live.back();
+		live.pop_back();
+		where[id] = -1;
+	};
+	for (int i = 0; i < pending; ++i) arm(i);
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < steps; ++i) {
+		arm(pending + i);
+		if (nextRand() % 10 && !live.empty()) {
+			int id = (*live[nextRand() % live.size()]).second;
+			w.cancel(live[where[id]]);
+			drop(id);
+		}
+		fired += w.advance(w.now() + 1, [&](Wheel::value_type &e) { drop(e.second); });
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-24s %8.2f ns/step  pending %zu  fired %lld\n", "timer_wheel",
+		sec * 1e9 / steps, w.size(), fired);
+}
+
+void runWheelInOrder(int pending) {
+	typedef sjtu::timer_wheel<int> Wheel;
+	seed = 19260817;
+	Wheel w;
+	std::vector<std::vector<Wheel::handle>> at(4096);
+	for (int i = 0; i < pending; ++i) {
+		unsigned d = nextRand() % 4096;
+		at[d].push_back(w.schedule((5 << 12) + d, i));
+	}
+	unsigned long long sum = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (auto &v : at)
+		for (auto &h : v) {
+			sum += w.top().second;
+			w.cancel(h);
+		}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-24s %8.2f ns/cancel+top  checksum %llu\n", "timer_wheel in order",
+		sec * 1e9 / pending, sum);
+}
+
+void runHeap(int pending, int steps) {
+	seed = 19260817;
+	sjtu::priority_queue<Timeout, Later> q;
+	std::vector<int> live, where;
+	std::vector<char> cancelled;
+	unsigned long long now = 0;
+	long long fired = 0;
+	auto arm = [&](int id) {
+		where.push_back((int)live.size());
+		live.push_back(id);
+		cancelled.push_back(0);
+		q.push(Timeout(now + 1 + nextRand() % horizon, id));
+	};
+	auto drop = [&](int id) {
+		int k = where[id];
+		where[live.back()] = k;
+		live[k] = live.back();
+		live.pop_back();
+		where[id] = -1;
+	};
+	for (int i = 0; i < pending; ++i) arm(i);
+	auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < steps; ++i) {
+		arm(pending + i);
+		if (nextRand() % 10 && !live.empty()) {
+			int id = live[nextRand() % live.size()];
+			cancelled[id] = 1;
+			drop(id);
+		}
+		++now;
+		while (!q.empty() && q.top().t <= now) {
+			int id = q.top().id;
+			q.pop();
+			if (!cancelled[id]) {
+				drop(id);
+				++fired;
+			}
+		}
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	printf("%-24s %8.2f ns/step  in heap %zu  fired %lld\n", "priority_queue (lazy)",
+		sec * 1e9 / steps, q.size(), fired);
+}
+
+int main(int argc, char *argv[]) {
+	int pending = argc > 1 ? atoi(argv[1]) : 1000000;
+	int steps = argc > 2 ? atoi(argv[2]) : 2000000;
+	runHeap(pending, steps);
+	runWheel(pending, steps);
+	runWheelInOrder(pending);
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#include <list>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+bool testBuild()
+{
+	std::vector<int> v;
+	for (int i = 0; i < 300001; ++i) v.push_back(rand());
+	sjtu::priority_queue<int> q(v.begin(), v.end());
+	if (q.size() != v.size()) return false;
+	std::list<int> more;
+	for (int i = 0; i < 1000; ++i) more.push_back(rand()), v.push_back(more.back());
+	q.push_range(more.begin(), more.end());
+	q.push_range(more.end(), more.end());
+	std::sort(v.begin(), v.end());
+	if (q.size() != v.size()) return false;
+	for (int i = (int)v.size() - 1; i >= 0; --i) {
+		if (q.top() != v[i]) return false;
+		q.pop();
+	}
+	sjtu::priority_queue<int> e(v.begin(), v.begin());
+	return q.empty() && e.empty();
+}
+
+struct Natural {
+	int x;
+	Natural(int _x = 0) { x = _x; }
+	friend bool operator<(const Natural &lhs, const Natural &rhs) {
+		if (lhs.x < 0 || rhs.x < 0)
+			throw sjtu::runtime_error();
+		return lhs.x < rhs.x;
+	}
+};
+
+bool testBuildException()
+{
+	std::vector<Natural> good, bad;
+	for (int i = 1; i <= 1000; ++i) good.push_back(Natural(i)), bad.push_back(Natural(i));
+	bad[777].x = -1;
+	sjtu::priority_queue<Natural> q(good.begin(), good.end());
+	try {
+		q.push_range(bad.begin(), bad.end());
+		return false;
+	} catch (sjtu::runtime_error &) {
+	}
+	try {
+		sjtu::priority_queue<Natural> r(bad.begin(), bad.end());
+		return false;
+	} catch (sjtu::runtime_error &) {
+	}
+	if (q.size() != 1000) return false;
+	for (int i = 1000; i >= 1; --i) {
+		if (q.top().x != i) return false;
+		q.pop();
+	}
+	return true;
+}
+
+int main()
+{
+	std::cout << (testBuild() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBuildException() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <cstdio>
+#include <queue>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+struct Task {
+	int prio, id;
+	Task(int p = 0, int i = 0) : prio(p), id(i) {}
+};
+struct ByPrio {
+	bool operator()(const Task &a, const Task &b) const {
+		return a.prio < b.prio;
+	}
+};
+// the sequence-number wrapper the stable mode replaces
+struct BySeq {
+	bool operator()(const Task &a, const Task &b) const {
+		return a.prio < b.prio || (a.prio == b.prio && a.id > b.id);
+	}
+};
+
+typedef sjtu::priority_queue<Task, ByPrio, true> Stable;
+
+bool testFifo()
+{
+	Stable q;
+	std::priority_queue<Task, std::vector<Task>, BySeq> std_q;
+	int id = 0;
+	for (int i = 0; i < 300000; ++i) {
+		if (rand() % 3 == 0 && !std_q.empty()) {
+			if (q.top().id != std_q.top().id) return false;
+			q.pop(), std_q.pop();
+		} else {
+			Task t(rand() % 20, id++);
+			q.push(t), std_q.push(t);
+		}
+	}
+	Stable c(q);
+	while (!std_q.empty()) {
+		if (q.top().id != std_q.top().id || c.pop_value().id != std_q.top().id) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty() && c.empty();
+}
+
+bool testRangeAndMerge()
+{
+	std::vector<Task> v;
+	for (int i = 0; i < 1000; ++i) v.push_back(Task(i % 5, i));
+	Stable a(v.begin(), v.end()), b;
+	// stamps continue after the range, so these come later
+	for (int i = 1000; i < 1500; ++i) a.emplace(i % 5, i);
+	for (int i = 0; i < 3000; ++i) b.push(Task(5 + i % 2, i));
+	a.merge(b);
+	// and after a merge they continue past both queues
+	for (int p = 0; p < 7; ++p) a.push(Task(p, 9999));
+	for (int p = 6; p >= 5; --p) {
+		for (int k = 0; k < 1500; ++k)
+			if (a.pop_value().id != k * 2 + (p - 5)) return false;
+		if (a.pop_value().id != 9999) return false;
+	}
+	for (int p = 4; p >= 0; --p) {
+		for (int k = 0; k < 300; ++k) {
+			Task t = a.pop_value();
+			if (t.prio != p || t.id != k * 5 + p) return false;
+		}
+		if (a.pop_value().id != 9999) return false;
+	}
+	return a.empty();
+}
+
+// only a stable queue carries the stamp counter
+bool testCounterRoom() {
+	typedef sjtu::priority_queue<Task, ByPrio> Plain;
+	if (sizeof(Stable) != sizeof(Plain) + sizeof(unsigned long long)) return false;
+	Plain q;
+	for (int i = 0; i < 100; ++i) q.push(Task(i % 3, i));
+	Plain r(q);
+	r.merge(q);
+	return r.size() == 200 && r.top().prio == 2;
+}
+
+int main()
+{
+	std::cout << (testFifo() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRangeAndMerge() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCounterRoom() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
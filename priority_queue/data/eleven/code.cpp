@@ -0,0 +1,64 @@
+#include <iostream>
+#include <cstdio>
+#include <queue>
+#include <vector>
+#include <string>
+
+#include "radix_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+template<class Key>
+bool testMonotone(Key spread)
+{
+	typedef std::pair<Key, int> item;
+	sjtu::radix_heap<Key, int> q;
+	std::priority_queue<item, std::vector<item>, std::greater<item>> std_q;
+	Key floor = 0;
+	for (int i = 0; i < 300000; ++i) {
+		if (rand() % 3 && !std_q.empty()) {
+			if (q.top().first != std_q.top().first || q.size() != std_q.size()) return false;
+			floor = q.top().first;
+			q.pop(), std_q.pop();
+		} else {
+			Key k = floor + (Key)(rand() % spread);
+			q.push(k, i), std_q.push(item(k, i));
+		}
+	}
+	while (!std_q.empty()) {
+		if (q.top().first != std_q.top().first) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty();
+}
+
+bool testFloor()
+{
+	sjtu::radix_heap<unsigned, std::string> q;
+	q.push(10, "ten");
+	q.push(5, "five");
+	if (q.top().second != "five" || q.floor() != 5) return false;
+	q.pop();
+	q.push(5, "five again");
+	try {
+		q.push(4, "too early");
+		return false;
+	} catch (sjtu::runtime_error &) {
+	}
+	if (q.top().second != "five again") return false;
+	q.clear();
+	q.push(0, "zero");
+	return q.size() == 1 && q.top().first == 0;
+}
+
+int main()
+{
+	std::cout << (testMonotone<unsigned>(1000) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testMonotone<unsigned long long>(1 << 30) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testMonotone<unsigned long long>(1) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testFloor() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827);
+}
+
+// the merge of data/five, over 64 heaps at once
+bool testMergeAll()
+{
+	const int K = 64, N = 20000;
+	std::vector<sjtu::priority_queue<int>> pq(K);
+	static int buffer[K * N + 1];
+	int pointer = 0;
+	for (int k = 0; k < K; k++)
+		for (int i = 1; i <= N; i++)
+			pq[k].push(buffer[++pointer] = rand());
+	pq[0].merge_all(pq.begin(), pq.end());
+	for (int k = 1; k < K; k++)
+		if (!pq[k].empty()) return false;
+	if ((int)pq[0].size() != pointer) return false;
+	std::sort(buffer + 1, buffer + pointer + 1);
+	while (pointer > 0) {
+		if (pq[0].top() != buffer[pointer]) return false;
+		pq[0].pop();
+		pointer--;
+	}
+	return pq[0].empty();
+}
+
+bool testOddAndEmpty()
+{
+	std::vector<sjtu::priority_queue<int>> pq(7);
+	sjtu::priority_queue<int> all;
+	for (int k = 0; k < 7; k += 2)
+		for (int i = 0; i < 100; i++) pq[k].push(k * 100 + i);
+	all.merge_all(pq.begin(), pq.end());
+	all.merge_all(pq.begin(), pq.begin());
+	if (all.size() != 400) return false;
+	for (int k = 6; k >= 0; k -= 2)
+		for (int i = 99; i >= 0; i--) {
+			if (all.top() != k * 100 + i) return false;
+			all.pop();
+		}
+	return all.empty();
+}
+
+int budget = -1;
+
+struct Countdown {
+	bool operator()(int a, int b) const {
+		if (budget >= 0 && budget-- == 0) throw sjtu::runtime_error();
+		return a < b;
+	}
+};
+
+// a throw part way leaves every element in exactly one queue
+bool testThrowKeeps()
+{
+	const int K = 9;
+	std::vector<sjtu::priority_queue<int, Countdown>> pq(K);
+	for (int k = 0; k < K; k++)
+		for (int i = 0; i < 500; i++) pq[k].push(k * 500 + i);
+	for (budget = 0; ; budget += 7) {
+		try {
+			pq[0].merge_all(pq.begin(), pq.end());
+			break;
+		} catch (sjtu::runtime_error &) {}
+		size_t total = 0;
+		for (int k = 0; k < K; k++) total += pq[k].size();
+		if (total != K * 500) return false;
+	}
+	budget = -1;
+	if (pq[0].size() != K * 500) return false;
+	for (int x = K * 500 - 1; x >= 0; x--) {
+		if (pq[0].top() != x) return false;
+		pq[0].pop();
+	}
+	return pq[0].empty();
+}
+
+int main()
+{
+	std::cout << (testMergeAll() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testOddAndEmpty() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testThrowKeeps() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
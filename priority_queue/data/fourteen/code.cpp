@@ -0,0 +1,120 @@
+#include <iostream>
+#include <cstdio>
+#include <queue>
+#include <vector>
+
+#include "external_priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+bool testAgainstStd()
+{
+	// a budget of 1000 ints forces a few hundred runs
+	sjtu::external_priority_queue<int> q(1000 * sizeof(int));
+	std::priority_queue<int> std_q;
+	for (int i = 0; i < 400000; ++i) {
+		if (rand() % 3 == 0 && !std_q.empty()) {
+			if (q.top() != std_q.top()) return false;
+			q.pop(), std_q.pop();
+		} else {
+			int x = rand() % 100000;
+			q.push(x), std_q.push(x);
+		}
+		if (q.size() != std_q.size()) return false;
+	}
+	if (q.run_count() == 0) return false;
+	while (!std_q.empty()) {
+		if (q.top() != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty() && q.run_count() == 0;
+}
+
+struct Fragile {
+	int x;
+};
+
+bool armed = false;
+
+struct FragileLess {
+	bool operator()(const Fragile &a, const Fragile &b) const {
+		if (armed && rand() % 50 == 0) throw sjtu::runtime_error();
+		return a.x < b.x;
+	}
+};
+
+bool testCompareThrows()
+{
+	sjtu::external_priority_queue<Fragile, FragileLess> q(64 * sizeof(Fragile));
+	std::priority_queue<int> std_q;
+	armed = true;
+	for (int i = 0; i < 20000; ++i) {
+		try {
+			if (rand() % 3 == 0 && !std_q.empty()) {
+				q.pop();
+				std_q.pop();
+			} else {
+				int x = rand() % 1000;
+				q.push(Fragile{x});
+				std_q.push(x);
+			}
+		} catch (sjtu::runtime_error &) {}
+		if (q.size() != std_q.size()) return false;
+	}
+	armed = false;
+	while (!std_q.empty()) {
+		if (q.top().x != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty();
+}
+
+bool testBounded()
+{
+	// 1000 ints of budget and 4 runs at most, for 300000 elements: the
+	// runs have to be merged again and again
+	sjtu::external_priority_queue<int> q(1000 * sizeof(int), 4);
+	std::priority_queue<int> std_q;
+	size_t most = 0;
+	for (int i = 0; i < 300000; ++i) {
+		int x = rand();
+		q.push(x), std_q.push(x);
+		if (i % 50 == 0) {
+			if (q.top() != std_q.top()) return false;
+			q.pop(), std_q.pop();
+		}
+		if (q.run_count() > most) most = q.run_count();
+	}
+	if (most != 4) return false;
+	while (!std_q.empty()) {
+		if (q.top() != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty() && q.run_count() == 0;
+}
+
+bool testEmpty()
+{
+	sjtu::external_priority_queue<int> q(16);
+	try {
+		q.top();
+		return false;
+	} catch (sjtu::container_is_empty &) {}
+	try {
+		q.pop();
+		return false;
+	} catch (sjtu::container_is_empty &) {}
+	return q.empty();
+}
+
+int main()
+{
+	std::cout << (testAgainstStd() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCompareThrows() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testEmpty() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBounded() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
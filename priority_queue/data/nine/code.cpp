@@ -0,0 +1,64 @@
+// push(T&&), emplace and pop_value must not copy a single element
+#include <iostream>
+#include <cstdio>
+#include <string>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+#include "pairing_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+struct Job {
+	static long long copies, moves;
+	int priority;
+	std::string payload;
+	Job(int p, const char *s) : priority(p), payload(s) {}
+	Job(const Job &other) : priority(other.priority), payload(other.payload) { ++copies; }
+	Job(Job &&other) noexcept : priority(other.priority), payload(std::move(other.payload)) { ++moves; }
+	Job &operator=(const Job &other) {
+		priority = other.priority, payload = other.payload;
+		++copies;
+		return *this;
+	}
+	Job &operator=(Job &&other) noexcept {
+		priority = other.priority, payload = std::move(other.payload);
+		++moves;
+		return *this;
+	}
+	friend bool operator<(const Job &a, const Job &b) {
+		return a.priority < b.priority;
+	}
+};
+long long Job::copies = 0, Job::moves = 0;
+
+template<class Queue>
+void test(const char *name)
+{
+	Job::copies = Job::moves = 0;
+	long long last = 1ll << 40, bad = 0;
+	{
+		Queue q;
+		for (int i = 0; i < 50000; ++i) {
+			if (i & 1) q.push(Job(rand() % 100000, "a job descriptor that does not fit in SSO"));
+			else q.emplace(rand() % 100000, "a job descriptor that does not fit in SSO");
+		}
+		for (int i = 0; i < 50000; ++i) {
+			Job j = q.pop_value();
+			if (j.priority > last || j.payload.size() != 41) ++bad;
+			last = j.priority;
+		}
+	}
+	std::cout << name << ": " << (bad ? "FAIL" : "OKAY") << ", copies = " << Job::copies << std::endl;
+}
+
+int main()
+{
+	test<sjtu::priority_queue<Job>>("priority_queue");
+	test<sjtu::dary_heap<Job>>("dary_heap");
+	test<sjtu::pairing_heap<Job>>("pairing_heap");
+	return 0;
+}
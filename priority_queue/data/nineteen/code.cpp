@@ -0,0 +1,115 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "../../../vector/src/vector.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827);
+}
+
+bool testSorted()
+{
+	sjtu::priority_queue<int> pq;
+	static int buffer[300000];
+	for (int i = 0; i < 300000; i++) pq.push(buffer[i] = rand());
+	std::sort(buffer, buffer + 300000, std::greater<int>());
+	sjtu::vector<int> snap;
+	snap.push_back(42);
+	pq.to_sorted_vector(snap);
+	if (snap.size() != 300001 || snap[0] != 42 || pq.size() != 300000) return false;
+	for (int i = 0; i < 300000; i++)
+		if (snap[i + 1] != buffer[i]) return false;
+	std::vector<int> drained;
+	pq.drain_sorted(drained);
+	if (!pq.empty() || drained.size() != 300000) return false;
+	for (int i = 0; i < 300000; i++)
+		if (drained[i] != buffer[i]) return false;
+	// the queue is still usable afterwards
+	pq.push(1), pq.push(3);
+	return pq.top() == 3 && pq.size() == 2;
+}
+
+struct Task {
+	int prio, id;
+	Task(int p = 0, int i = 0) : prio(p), id(i) {}
+};
+struct ByPrio {
+	bool operator()(const Task &a, const Task &b) const {
+		return a.prio < b.prio;
+	}
+};
+
+bool testStable()
+{
+	sjtu::priority_queue<Task, ByPrio, true> pq;
+	for (int i = 0; i < 10000; i++) pq.push(Task(rand() % 7 & 7, i));
+	sjtu::priority_queue<Task, ByPrio, true> copy(pq);
+	sjtu::vector<Task> snap;
+	pq.to_sorted_vector(snap);
+	for (size_t i = 0; i < snap.size(); i++) {
+		Task t = copy.pop_value();
+		if (t.id != snap[i].id) return false;
+	}
+	return copy.empty() && snap.size() == 10000;
+}
+
+bool testEmpty()
+{
+	sjtu::priority_queue<int> pq;
+	sjtu::vector<int> v;
+	pq.to_sorted_vector(v);
+	pq.drain_sorted(v);
+	return v.empty() && pq.empty();
+}
+
+int budget = -1;
+
+template<class T>
+struct Countdown {
+	bool operator()(const T &a, const T &b) const {
+		if (budget >= 0 && budget-- == 0) throw sjtu::runtime_error();
+		return a < b;
+	}
+};
+
+// a throwing Compare leaves the queue as it was, moved or copied
+template<class T, class Make>
+bool testThrowRestores(Make make)
+{
+	sjtu::priority_queue<T, Countdown<T>> pq;
+	for (int i = 0; i < 2000; i++) pq.push(make(rand() % 500));
+	for (int stop = 0; stop < 20000; stop += 997) {
+		std::vector<T> out;
+		budget = stop;
+		try {
+			pq.drain_sorted(out);
+			return false;
+		} catch (sjtu::runtime_error &) {}
+		if (!out.empty() || pq.size() != 2000) return false;
+	}
+	budget = -1;
+	sjtu::priority_queue<T, Countdown<T>> copy(pq);
+	std::vector<T> out;
+	pq.drain_sorted(out);
+	for (size_t i = 0; i < out.size(); i++) {
+		if (copy.top() != out[i]) return false;
+		copy.pop();
+	}
+	return out.size() == 2000 && pq.empty() && copy.empty();
+}
+
+int main()
+{
+	std::cout << (testSorted() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStable() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testEmpty() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testThrowRestores<int>([](int x) { return x; }) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testThrowRestores<std::string>([](int x) { return std::to_string(x) + " and some padding"; }) ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
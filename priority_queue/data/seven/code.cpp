@@ -0,0 +1,202 @@
+#include <iostream>
+#include <cstdio>
+#include <queue>
+#include <functional>
+#include <set>
+#include <vector>
+
+#include "pairing_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+bool testRandom()
+{
+	sjtu::pairing_heap<int> q;
+	std::priority_queue<int> std_q;
+	for (int i = 0; i < 300000; ++i) {
+		if (rand() % 3 && !std_q.empty()) {
+			if (q.top() != std_q.top() || q.size() != std_q.size()) return false;
+			q.pop(), std_q.pop();
+		} else {
+			int x = rand() % 1000;
+			q.push(x), std_q.push(x);
+		}
+	}
+	sjtu::pairing_heap<int> copied(q);
+	q = q;
+	while (!std_q.empty()) {
+		if (q.top() != std_q.top() || copied.top() != std_q.top()) return false;
+		q.pop(), copied.pop(), std_q.pop();
+	}
+	return q.empty() && copied.empty();
+}
+
+bool testMerge()
+{
+	sjtu::pairing_heap<int, std::greater<int>> a, b;
+	std::priority_queue<int, std::vector<int>, std::greater<int>> std_q;
+	for (int i = 0; i < 400000; ++i) {
+		int x = rand();
+		(i & 1 ? a : b).push(x);
+		std_q.push(x);
+	}
+	a.merge(b);
+	if (!b.empty() || a.size() != std_q.size()) return false;
+	b.push(1);
+	while (!std_q.empty()) {
+		if (a.top() != std_q.top()) return false;
+		a.pop(), std_q.pop();
+	}
+	return a.empty() && b.size() == 1;
+}
+
+bool testDeep()
+{
+	// increasing pushes give a root with a single huge child list
+	sjtu::pairing_heap<int> q;
+	for (int i = 0; i < 1000000; ++i) q.push(i);
+	sjtu::pairing_heap<int> copied(q);
+	for (int i = 999999; i >= 0; --i) {
+		if (copied.top() != i) return false;
+		copied.pop();
+	}
+	return q.size() == 1000000;
+}
+
+bool testHandles()
+{
+	// values are key * 1000000 + id, so the popped id is always known
+	typedef sjtu::pairing_heap<long long>::handle handle;
+	const int N = 100000;
+	static handle h[N];
+	static long long val[N];
+	static bool alive[N];
+	sjtu::pairing_heap<long long> q;
+	std::multiset<long long> std_q;
+	int ids = 0;
+	for (int step = 0; step < 400000; ++step) {
+		int op = rand() % 5;
+		if (op == 0 || std_q.empty()) {
+			if (ids == N) continue;
+			val[ids] = (long long)(rand() % 100000) * 1000000 + ids;
+			h[ids] = q.push(val[ids]);
+			alive[ids] = true;
+			std_q.insert(val[ids]);
+			++ids;
+		} else if (op == 1) {
+			long long top = q.top();
+			if (top != *std_q.rbegin()) return false;
+			alive[top % 1000000] = false;
+			std_q.erase(--std_q.end());
+			q.pop();
+		} else {
+			int id = rand() % ids;
+			if (!alive[id]) continue;
+			std_q.erase(std_q.find(val[id]));
+			long long key = rand() % 100000;
+			long long now = key * 1000000 + id;
+			if (op == 2) {
+				if (now >= val[id]) q.increase_key(h[id], now);
+				else q.decrease_key(h[id], now);
+			} else if (op == 3) {
+				q.modify(h[id], now);
+			} else {
+				q.erase(h[id]);
+				alive[id] = false;
+				continue;
+			}
+			if (*h[id] != now) return false;
+			val[id] = now;
+			std_q.insert(now);
+		}
+		if (q.size() != std_q.size()) return false;
+	}
+	while (!std_q.empty()) {
+		if (q.top() != *std_q.rbegin()) return false;
+		std_q.erase(--std_q.end());
+		q.pop();
+	}
+	return q.empty();
+}
+
+int budget = -1;
+struct Flaky {
+	int x;
+	Flaky(int _x = 0) { x = _x; }
+	friend bool operator<(const Flaky &lhs, const Flaky &rhs) {
+		if (budget >= 0 && budget-- == 0)
+			throw sjtu::runtime_error();
+		return lhs.x < rhs.x;
+	}
+};
+
+bool testCompareException()
+{
+	sjtu::pairing_heap<Flaky> q;
+	std::priority_queue<int> std_q;
+	for (int i = 0; i < 20000; ++i) {
+		budget = rand() % 40;
+		if (rand() % 3 && !std_q.empty()) {
+			try {
+				q.pop();
+				std_q.pop();
+			} catch (sjtu::runtime_error) {
+			}
+		} else {
+			int x = rand() % 5000;
+			try {
+				q.push(Flaky(x));
+				std_q.push(x);
+			} catch (sjtu::runtime_error) {
+			}
+		}
+		budget = -1;
+		if (q.size() != std_q.size() || (!std_q.empty() && q.top().x != std_q.top())) return false;
+	}
+	while (!std_q.empty()) {
+		if (q.top().x != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty();
+}
+
+// increase_key and decrease_key called the wrong way round still keep
+// the heap in order
+bool testWrongWay()
+{
+	const int N = 5000;
+	sjtu::pairing_heap<int> q;
+	std::vector<sjtu::pairing_heap<int>::handle> h;
+	std::multiset<int> std_q;
+	static int val[N];
+	for (int i = 0; i < N; i++) {
+		h.push_back(q.push(val[i] = rand() % 100000));
+		std_q.insert(val[i]);
+	}
+	for (int k = 0; k < 20000; k++) {
+		int id = rand() % N, now = rand() % 100000;
+		std_q.erase(std_q.find(val[id]));
+		std_q.insert(val[id] = now);
+		if (k & 1) q.increase_key(h[id], now);
+		else q.decrease_key(h[id], now);
+	}
+	for (auto it = std_q.rbegin(); it != std_q.rend(); ++it) {
+		if (q.top() != *it) return false;
+		q.pop();
+	}
+	return q.empty();
+}
+
+int main()
+{
+	std::cout << (testRandom() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testMerge() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testDeep() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testHandles() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCompareException() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testWrongWay() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,143 @@
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "timer_wheel.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+typedef sjtu::timer_wheel<int> Wheel;
+typedef std::pair<unsigned long long, int> Key;
+
+// every pending timer is also in std_q, keyed by (deadline, id) so that
+// equal deadlines fire in the order they were scheduled
+bool testAgainstMap(unsigned long long spread)
+{
+	Wheel w(12345);
+	std::map<Key, Wheel::handle> std_q;
+	std::vector<Key> armed;
+	int id = 0;
+	for (int i = 0; i < 300000; ++i) {
+		int op = rand() % 10;
+		if (op < 4) {
+			unsigned long long d = w.now() + (unsigned long long)rand() * rand() % spread;
+			std_q[Key(d, id)] = w.schedule(d, id);
+			armed.push_back(Key(d, id++));
+		} else if (op < 7) {
+			// cancel some timer, perhaps one that already fired
+			if (armed.empty()) continue;
+			size_t k = rand() % armed.size();
+			auto it = std_q.find(armed[k]);
+			armed[k] = armed.back();
+			armed.pop_back();
+			if (it == std_q.end()) continue;
+			w.cancel(it->second);
+			std_q.erase(it);
+		} else if (op < 9) {
+			if (std_q.empty()) continue;
+			Key k = std_q.begin()->first;
+			if (w.top().first != k.first || w.top().second != k.second) return false;
+			w.pop();
+			std_q.erase(std_q.begin());
+			if (w.now() != k.first) return false;
+		} else {
+			unsigned long long t = w.now() + (unsigned long long)rand() % spread;
+			bool ok = true;
+			w.advance(t, [&](Wheel::value_type &e) {
+				if (std_q.empty() || std_q.begin()->first != Key(e.first, e.second)) ok = false;
+				else std_q.erase(std_q.begin());
+			});
+			if (!ok || w.now() != t) return false;
+			if (!std_q.empty() && std_q.begin()->first.first <= t) return false;
+		}
+		if (w.size() != std_q.size()) return false;
+	}
+	while (!std_q.empty()) {
+		if (w.top().second != std_q.begin()->first.second) return false;
+		w.pop();
+		std_q.erase(std_q.begin());
+	}
+	return w.empty();
+}
+
+bool testPeekDoesNotMoveClock()
+{
+	Wheel w;
+	w.schedule(1000000, 1);
+	if (w.top().first != 1000000 || w.now() != 0) return false;
+	w.schedule(5, 2);
+	if (w.top().second != 2) return false;
+	try {
+		w.advance(10, [](Wheel::value_type &) {});
+		w.schedule(9, 3);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	return w.size() == 1 && w.now() == 10;
+}
+
+// a peek after each cancel used to scan the whole slot of the next timer
+// again; with all of them in one slot above level 0 that was quadratic.
+// now and then a timer goes in before the ones peeked at, with ties
+bool testCancelInOrder()
+{
+	Wheel w;
+	std::map<Key, Wheel::handle> std_q;
+	int id = 0;
+	for (int i = 0; i < 200000; ++i) {
+		unsigned long long d = (5 << 12) + rand() % 4096;
+		std_q[Key(d, id)] = w.schedule(d, id);
+		++id;
+	}
+	while (!std_q.empty()) {
+		Key k = std_q.begin()->first;
+		if (w.top().first != k.first || w.top().second != k.second) return false;
+		if (w.now() != 0) return false;
+		if (rand() % 1000 == 0) {
+			unsigned long long d = rand() % (k.first + 1);
+			std_q[Key(d, id)] = w.schedule(d, id);
+			std_q[Key(d, id + 1)] = w.schedule(d, id + 1);
+			id += 2;
+			continue;
+		}
+		w.cancel(std_q.begin()->second);
+		std_q.erase(std_q.begin());
+	}
+	return w.empty();
+}
+
+bool testErrors()
+{
+	Wheel w;
+	try {
+		w.top();
+		return false;
+	} catch (sjtu::container_is_empty &) {}
+	try {
+		w.pop();
+		return false;
+	} catch (sjtu::container_is_empty &) {}
+	try {
+		w.cancel(Wheel::handle());
+		return false;
+	} catch (sjtu::invalid_iterator &) {}
+	w.schedule(~0ull, 0);
+	w.schedule(0, 1);
+	w.pop();
+	w.pop();
+	return w.empty() && w.now() == ~0ull;
+}
+
+int main()
+{
+	std::cout << (testAgainstMap(100) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testAgainstMap(1ull << 40) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testPeekDoesNotMoveClock() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCancelInOrder() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testErrors() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
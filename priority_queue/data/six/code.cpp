@@ -0,0 +1,135 @@
+#include <iostream>
+#include <cstdio>
+#include <queue>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <string>
+
+#include "dary_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+template<size_t D>
+bool testRandom()
+{
+	sjtu::dary_heap<int, std::less<int>, D> q;
+	std::priority_queue<int> std_q;
+	for (int i = 0; i < 200000; ++i) {
+		if (rand() % 3 && !std_q.empty()) {
+			if (q.top() != std_q.top() || q.size() != std_q.size()) return false;
+			q.pop(), std_q.pop();
+		} else {
+			int x = rand() % 1000;
+			q.push(x), std_q.push(x);
+		}
+	}
+	while (!std_q.empty()) {
+		if (q.top() != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return q.empty();
+}
+
+bool testCopyAndMerge()
+{
+	sjtu::dary_heap<long long, std::greater<long long>> a, b;
+	for (int i = 0; i < 1000; ++i) a.push(rand());
+	for (int i = 0; i < 3000; ++i) b.push(rand());
+	sjtu::dary_heap<long long, std::greater<long long>> c(a);
+	c = c;
+	a.merge(b);
+	if (!b.empty() || a.size() != 4000 || c.size() != 1000) return false;
+	long long last = -1;
+	while (!a.empty()) {
+		if (a.top() < last) return false;
+		last = a.top();
+		a.pop();
+	}
+	return true;
+}
+
+bool testBuild()
+{
+	std::vector<int> v, w;
+	for (int i = 0; i < 100000; ++i) v.push_back(rand() % 50000);
+	for (int i = 0; i < 777; ++i) w.push_back(rand() % 50000);
+	sjtu::dary_heap<int, std::less<int>, 3> q(v.begin(), v.end());
+	q.push_range(w.begin(), w.end());
+	v.insert(v.end(), w.begin(), w.end());
+	std::sort(v.begin(), v.end());
+	if (q.size() != v.size()) return false;
+	for (int i = (int)v.size() - 1; i >= 0; --i) {
+		if (q.top() != v[i]) return false;
+		q.pop();
+	}
+	return q.empty();
+}
+
+struct Natural {
+	int x;
+	Natural(int _x = 0) { x = _x; }
+	friend bool operator<(const Natural &lhs, const Natural &rhs) {
+		if (lhs.x < 0 || rhs.x < 0)
+			throw sjtu::runtime_error();
+		return lhs.x < rhs.x;
+	}
+};
+
+bool testCompareException()
+{
+	sjtu::dary_heap<Natural> q;
+	std::priority_queue<int> std_q;
+	for (int i = 1; i <= 2000; ++i) {
+		int x = rand() % 10 == 0 ? -i : i;
+		try {
+			q.push(Natural(x));
+			std_q.push(x);
+		} catch (sjtu::runtime_error) {
+			if (x >= 0) return false;
+		}
+	}
+	if (q.size() != std_q.size()) return false;
+	while (!std_q.empty()) {
+		if (q.top().x != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return true;
+}
+
+// pushing an element of the heap itself, also when the array is full
+bool testPushOwn()
+{
+	sjtu::dary_heap<std::string> q;
+	std::priority_queue<std::string> std_q;
+	for (int i = 0; i < 1000; ++i) {
+		std::string s = std::to_string(rand() % 100000) + std::string(30, 'x');
+		q.push(s);
+		std_q.push(s);
+		if (rand() % 3 == 0) {
+			q.push(q.top());
+			std_q.push(std_q.top());
+		}
+	}
+	if (q.size() != std_q.size()) return false;
+	while (!std_q.empty()) {
+		if (q.top() != std_q.top()) return false;
+		q.pop(), std_q.pop();
+	}
+	return true;
+}
+
+int main()
+{
+	std::cout << (testRandom<2>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRandom<4>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRandom<7>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCopyAndMerge() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBuild() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCompareException() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testPushOwn() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,34 @@
+#include <iostream>
+#include <cstdio>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+// the element count is kept by the queue, not by the nodes
+bool testSize()
+{
+	sjtu::priority_queue<int> a, b;
+	if (a.size() != 0) return false;
+	for (int i = 0; i < 1000; i++) a.push(i);
+	std::vector<int> v(500, 7);
+	b.push_range(v.begin(), v.end());
+	b.emplace(3);
+	if (a.size() != 1000 || b.size() != 501) return false;
+	sjtu::priority_queue<int> c(a);
+	c.pop();
+	a.merge(b);
+	if (a.size() != 1501 || b.size() != 0 || c.size() != 999) return false;
+	b = a;
+	while (!a.empty()) a.pop_value();
+	if (a.size() != 0 || b.size() != 1501) return false;
+	sjtu::priority_queue<int> d(v.begin(), v.end());
+	d.clear();
+	// smaller than the old node: two children, rank, size and the value
+	return d.size() == 0 && sizeof(sjtu::Node<int>) < 2 * sizeof(void*) + 3 * sizeof(int);
+}
+
+int main()
+{
+	std::cout << (testSize() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
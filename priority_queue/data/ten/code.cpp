@@ -0,0 +1,61 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "bounded_priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+template<size_t K, class Compare>
+bool testStream(int n)
+{
+	sjtu::bounded_priority_queue<int, K, Compare> q;
+	std::vector<int> all, kept;
+	int accepted = 0;
+	for (int i = 0; i < n; ++i) {
+		int x = rand() % 1000000;
+		all.push_back(x);
+		accepted += q.push(x);
+		if (q.size() != std::min((size_t)i + 1, K)) return false;
+	}
+	std::sort(all.begin(), all.end(), [](int a, int b) { return Compare()(b, a); });
+	if (all.size() > K) all.resize(K);
+	if (!all.empty() && q.boundary() != all.back()) return false;
+	kept.push_back(-1);
+	q.drain_sorted(kept);
+	kept.erase(kept.begin());
+	return kept == all && q.empty() && accepted >= (int)all.size();
+}
+
+bool testPop()
+{
+	sjtu::bounded_priority_queue<long long, 5> q;
+	for (int i = 1; i <= 100; ++i) q.push(i);
+	if (!q.full() || q.push(3)) return false;
+	long long expect = 96;
+	while (!q.empty()) {
+		if (q.boundary() != expect) return false;
+		if (q.pop_value() != expect++) return false;
+	}
+	try {
+		q.pop();
+	} catch (sjtu::container_is_empty &) {
+		return true;
+	}
+	return false;
+}
+
+int main()
+{
+	std::cout << (testStream<100, std::less<int>>(1000000) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStream<1000, std::greater<int>>(500000) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStream<64, std::less<int>>(10) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStream<1, std::less<int>>(1000) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testPop() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,69 @@
+#include <iostream>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "concurrent_priority_queue.hpp"
+
+bool testNothingLost()
+{
+	const int threads = 4, per = 100000;
+	sjtu::concurrent_priority_queue<int> q(threads);
+	std::vector<char> seen(threads * per, 0);
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t)
+		pool.emplace_back([&q, t]() {
+			for (int i = 0; i < per; ++i) q.push(t * per + i);
+		});
+	for (auto &th : pool) th.join();
+	pool.clear();
+	if (q.size() != (size_t)threads * per) return false;
+	std::vector<std::vector<int>> got(threads);
+	for (int t = 0; t < threads; ++t)
+		pool.emplace_back([&q, &got, t]() {
+			int x;
+			while (q.try_pop(x)) got[t].push_back(x);
+		});
+	for (auto &th : pool) th.join();
+	for (int t = 0; t < threads; ++t)
+		for (int x : got[t]) {
+			if (seen[x]) return false;
+			seen[x] = 1;
+		}
+	for (char c : seen) if (!c) return false;
+	return q.empty();
+}
+
+bool testSingleThreadOrder()
+{
+	// with a single heap there is nothing to relax
+	sjtu::concurrent_priority_queue<int, std::less<int>, 1> q(1);
+	for (int i = 0; i < 1000; ++i) q.push(i);
+	int x, last = 1000;
+	while (q.try_pop(x)) {
+		if (x >= last) return false;
+		last = x;
+	}
+	return last == 0;
+}
+
+bool testTwoChoices()
+{
+	// two heaps and nobody else: every pop compares both, so it is exact
+	sjtu::concurrent_priority_queue<int, std::less<int>, 2> q(1);
+	for (int i = 0; i < 10000; ++i) q.push(i);
+	int x, last = 10000;
+	while (q.try_pop(x)) {
+		if (x != last - 1) return false;
+		last = x;
+	}
+	return last == 0;
+}
+
+int main()
+{
+	std::cout << (testNothingLost() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testSingleThreadOrder() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testTwoChoices() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include <iostream>
+#include <cstdio>
+#include <set>
+#include <string>
+
+#include "minmax_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+int budget = -1;
+struct Flaky {
+	int x;
+	Flaky(int _x = 0) { x = _x; }
+	friend bool operator<(const Flaky &lhs, const Flaky &rhs) {
+		if (budget >= 0 && budget-- == 0)
+			throw sjtu::runtime_error();
+		return lhs.x < rhs.x;
+	}
+};
+
+bool testRandom(int range)
+{
+	sjtu::minmax_heap<int> q;
+	std::multiset<int> s;
+	for (int i = 0; i < 300000; ++i) {
+		int op = rand() % 5;
+		if (op >= 2 || s.empty()) {
+			int x = rand() % range;
+			q.push(x), s.insert(x);
+		} else if (op == 0) {
+			if (q.top_min() != *s.begin()) return false;
+			q.pop_min(), s.erase(s.begin());
+		} else {
+			if (q.top_max() != *s.rbegin()) return false;
+			q.pop_max(), s.erase(--s.end());
+		}
+		if (q.size() != s.size()) return false;
+	}
+	sjtu::minmax_heap<int> copied(q);
+	while (!s.empty()) {
+		if (copied.top_min() != *s.begin() || copied.top_max() != *s.rbegin()) return false;
+		copied.pop_max(), s.erase(--s.end());
+	}
+	return copied.empty() && q.size() > 10000;
+}
+
+bool testCompareException()
+{
+	sjtu::minmax_heap<Flaky> q;
+	std::multiset<int> s;
+	for (int i = 0; i < 30000; ++i) {
+		int op = rand() % 5;
+		budget = rand() % 12;
+		try {
+			if (op >= 2 || s.empty()) {
+				int x = rand() % 10000;
+				q.push(Flaky(x));
+				s.insert(x);
+			} else if (op == 0) {
+				q.pop_min();
+				s.erase(s.begin());
+			} else {
+				q.pop_max();
+				s.erase(--s.end());
+			}
+		} catch (sjtu::runtime_error &) {
+		}
+		budget = -1;
+		if (q.size() != s.size()) return false;
+		if (!s.empty() && (q.top_min().x != *s.begin() || q.top_max().x != *s.rbegin())) return false;
+	}
+	return true;
+}
+
+// pushing an element of the heap itself, also when the array is full
+bool testPushOwn()
+{
+	sjtu::minmax_heap<std::string> q;
+	std::multiset<std::string> s;
+	for (int i = 0; i < 2000; ++i) {
+		std::string x = std::to_string(rand() % 100000) + std::string(30, 'x');
+		q.push(x), s.insert(x);
+		int op = rand() % 4;
+		if (op == 0) q.push(q.top_max()), s.insert(*s.rbegin());
+		else if (op == 1) q.push(q.top_min()), s.insert(*s.begin());
+	}
+	if (q.size() != s.size()) return false;
+	while (!s.empty()) {
+		if (q.top_min() != *s.begin() || q.top_max() != *s.rbegin()) return false;
+		q.pop_max(), s.erase(--s.end());
+	}
+	return q.empty();
+}
+
+int main()
+{
+	std::cout << (testRandom(5) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRandom(1000000) ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCompareException() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testPushOwn() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827);
+}
+
+bool testVisitAll()
+{
+	sjtu::priority_queue<int> pq;
+	static int buffer[200000], seen[200000];
+	for (int i = 0; i < 200000; i++) pq.push(buffer[i] = rand());
+	for (int i = 0; i < 50000; i++) pq.pop();
+	int cnt = 0;
+	pq.for_each([&](const int &x) {
+		if (cnt < 200000) seen[cnt] = x;
+		cnt++;
+	});
+	if (cnt != 150000 || (int)pq.size() != cnt) return false;
+	std::sort(buffer, buffer + 200000);
+	std::sort(seen, seen + cnt);
+	for (int i = 0; i < cnt; i++)
+		if (seen[i] != buffer[i]) return false;
+	for (int i = cnt - 1; i >= 0; i--) {
+		if (pq.top() != buffer[i]) return false;
+		pq.pop();
+	}
+	return pq.empty();
+}
+
+bool testThrowRestores()
+{
+	sjtu::priority_queue<int> pq;
+	for (int i = 0; i < 10000; i++) pq.push(rand() % 1000);
+	sjtu::priority_queue<int> copy(pq);
+	for (int stop = 0; stop < 10000; stop += 997) {
+		int cnt = 0;
+		try {
+			pq.for_each([&](const int &) {
+				if (cnt++ == stop) throw sjtu::runtime_error();
+			});
+			return false;
+		} catch (sjtu::runtime_error &) {}
+	}
+	while (!copy.empty()) {
+		if (pq.top() != copy.top()) return false;
+		pq.pop(), copy.pop();
+	}
+	return pq.empty();
+}
+
+bool testEmpty()
+{
+	sjtu::priority_queue<int> pq;
+	int cnt = 0;
+	pq.for_each([&](const int &) { cnt++; });
+	return cnt == 0;
+}
+
+int main()
+{
+	std::cout << (testVisitAll() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testThrowRestores() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testEmpty() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
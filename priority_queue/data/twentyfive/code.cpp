@@ -0,0 +1,154 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "lazy_priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+typedef sjtu::lazy_priority_queue<int> Lazy;
+
+// q holds exactly v
+template<class Queue>
+bool holds(const Queue &q, std::vector<int> v)
+{
+	if (q.size() != v.size()) return false;
+	Queue c(q);
+	std::sort(v.begin(), v.end());
+	for (int i = (int)v.size() - 1; i >= 0; --i) {
+		if (c.top() != v[i]) return false;
+		c.pop();
+	}
+	return c.empty();
+}
+
+bool testAgainstSorted()
+{
+	Lazy q;
+	std::vector<int> v;
+	for (int i = 0; i < 20000; ++i) {
+		int op = rand() % 4;
+		if (op < 3) {
+			int x = rand() % 100000;
+			q.push(x);
+			v.push_back(x);
+		} else if (!v.empty()) {
+			std::vector<int>::iterator it = std::max_element(v.begin(), v.end());
+			if (q.top() != *it) return false;
+			q.pop();
+			v.erase(it);
+		}
+		if (i % 5000 == 0 && !holds(q, v)) return false;
+	}
+	return holds(q, v);
+}
+
+bool testMerge()
+{
+	Lazy big;
+	std::vector<int> v;
+	for (int round = 0; round < 50; ++round) {
+		// many small queues in, a few pops out
+		for (int k = 0; k < 40; ++k) {
+			Lazy small;
+			sjtu::priority_queue<int> plain;
+			int best = -1;
+			for (int j = 0; j < 5; ++j) {
+				int x = rand() % 100000, y = rand() % 100000;
+				small.push(x); plain.push(y);
+				v.push_back(x); v.push_back(y);
+				best = std::max(best, x);
+			}
+			if (k % 7 == 0) {
+				if (small.top() != best) return false;
+				small.pop();
+				v.erase(std::find(v.begin(), v.end(), best));
+			}
+			big.merge(small);
+			big.merge(plain);
+			if (!small.empty() || !plain.empty()) return false;
+		}
+		if (big.pending() == 0) return false;
+		for (int j = 0; j < 3; ++j) {
+			std::vector<int>::iterator it = std::max_element(v.begin(), v.end());
+			if (big.top() != *it) return false;
+			big.pop();
+			v.erase(it);
+		}
+		if (big.pending() != 0) return false;
+	}
+	big.merge(big);
+	Lazy copy(big), assigned;
+	assigned.push(1);
+	assigned = big;
+	return holds(big, v) && holds(copy, v) && holds(assigned, v);
+}
+
+// throws on the fuse-th comparison from now
+int fuse = -1;
+
+struct Fragile {
+	bool operator()(int a, int b) const {
+		if (fuse >= 0 && fuse-- == 0) throw sjtu::runtime_error();
+		return a < b;
+	}
+};
+
+bool testThrow()
+{
+	typedef sjtu::lazy_priority_queue<int, Fragile> Queue;
+	Queue q;
+	std::vector<int> v;
+	for (int round = 0; round < 100; ++round) {
+		for (int k = 0; k < 30; ++k) {
+			int x = rand() % 1000;
+			q.push(x);
+			v.push_back(x);
+		}
+		// a throw halfway through consolidation loses nothing
+		fuse = rand() % 40;
+		try {
+			q.pop();
+			fuse = -1;
+			v.erase(std::max_element(v.begin(), v.end()));
+		} catch (sjtu::runtime_error &) {
+			fuse = -1;
+		}
+		if (q.size() != v.size()) return false;
+	}
+	return holds(q, v);
+}
+
+bool testStrings()
+{
+	sjtu::lazy_priority_queue<std::string> q, r;
+	std::vector<std::string> v;
+	for (int i = 0; i < 1000; ++i) {
+		std::string s = std::to_string(rand() % 100000) + std::string(20, 'x');
+		(i & 1 ? q : r).push(s);
+		v.push_back(s);
+	}
+	q.merge(r);
+	std::sort(v.begin(), v.end());
+	for (int i = 0; i < 10; ++i) {
+		if (q.top() != v[v.size() - 1 - i]) return false;
+		q.pop();
+	}
+	// the rest is pending or consolidated, and freed either way
+	for (int i = 0; i < 100; ++i) q.push(v[i]);
+	return q.size() == 1090;
+}
+
+int main()
+{
+	std::cout << (testAgainstSorted() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testMerge() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testThrow() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStrings() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,194 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+#include "pairing_heap.hpp"
+#include "minmax_heap.hpp"
+#include "bounded_priority_queue.hpp"
+#include "external_priority_queue.hpp"
+#include "concurrent_priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+const int ids = 100;
+
+// orders ids by a table of ranks the queue gets at run time
+struct RankLess {
+	const int *rank;
+	RankLess(const int *r = nullptr) : rank(r) {}
+	bool operator()(int a, int b) const {
+		return rank[a] < rank[b];
+	}
+};
+
+typedef sjtu::priority_queue<int, RankLess> Queue;
+
+int up[ids], down[ids];
+
+// q pops exactly the ids of v, highest rank first
+bool popsBy(Queue q, std::vector<int> v, const int *rank)
+{
+	if (q.size() != v.size()) return false;
+	std::sort(v.begin(), v.end(), [&](int a, int b) { return rank[a] > rank[b]; });
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (rank[q.top()] != rank[v[i]]) return false;
+		q.pop();
+	}
+	return q.empty();
+}
+
+bool testStored()
+{
+	Queue q{ RankLess(up) }, r{ RankLess(down) };
+	std::vector<int> v;
+	for (int i = 0; i < 500; ++i) {
+		int x = rand() % ids;
+		q.push(x); r.push(x);
+		v.push_back(x);
+	}
+	if (q.value_comp().rank != up || r.value_comp().rank != down) return false;
+	if (!popsBy(q, v, up) || !popsBy(r, v, down)) return false;
+	// copies and assignment carry the comparator along
+	Queue c(q);
+	if (!popsBy(c, v, up)) return false;
+	c = r;
+	if (c.value_comp().rank != down || !popsBy(c, v, down)) return false;
+	std::vector<int> w;
+	r.to_sorted_vector(w);
+	for (size_t i = 1; i < w.size(); ++i)
+		if (down[w[i - 1]] < down[w[i]]) return false;
+	return w.size() == v.size();
+}
+
+bool testRange()
+{
+	std::vector<int> v;
+	for (int i = 0; i < 300; ++i) v.push_back(rand() % ids);
+	Queue q(v.begin(), v.end(), RankLess(down));
+	if (!popsBy(q, v, down)) return false;
+	std::vector<int> more;
+	for (int i = 0; i < 100; ++i) more.push_back(rand() % ids);
+	q.push_range(more.begin(), more.end());
+	v.insert(v.end(), more.begin(), more.end());
+	if (!popsBy(q, v, down)) return false;
+	// merge orders by the queue merged into
+	Queue a{ RankLess(down) }, b{ RankLess(up) };
+	std::vector<int> va;
+	for (int i = 0; i < 200; ++i) {
+		int x = rand() % ids;
+		(i & 1 ? a : b).push(x);
+		va.push_back(x);
+	}
+	b = Queue(RankLess(down));
+	for (int i = 0; i < 200; i += 2) b.push(va[i]);
+	a.merge(b);
+	return b.empty() && popsBy(a, va, down);
+}
+
+bool testStable()
+{
+	// every id ranked alike: only the stamps decide
+	int same[ids] = {};
+	sjtu::priority_queue<int, RankLess, true> q{ RankLess(same) };
+	for (int i = 0; i < ids; ++i) q.push(i);
+	for (int i = 0; i < ids; ++i) {
+		if (q.top() != i) return false;
+		q.pop();
+	}
+	return q.empty();
+}
+
+bool testPersistent()
+{
+	typedef sjtu::persistent_priority_queue<int, RankLess> Persistent;
+	Persistent q{ RankLess(down) };
+	std::vector<int> v;
+	for (int i = 0; i < 300; ++i) {
+		int x = rand() % ids;
+		q = q.push(x);
+		v.push_back(x);
+	}
+	// every version carries the comparator along, merged ones too
+	Persistent m = q.pop().merge(q);
+	if (q.value_comp().rank != down || m.value_comp().rank != down) return false;
+	if (m.size() != 2 * v.size() - 1) return false;
+	std::sort(v.begin(), v.end(), [&](int a, int b) { return down[a] > down[b]; });
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (down[q.top()] != down[v[i]]) return false;
+		q = q.pop();
+	}
+	return q.empty();
+}
+
+// the other heaps keep their comparator too; q pops exactly v, by down
+template<class Heap>
+bool heapPopsBy(Heap q, std::vector<int> v)
+{
+	if (q.value_comp().rank != down || q.size() != v.size()) return false;
+	std::sort(v.begin(), v.end(), [&](int a, int b) { return down[a] > down[b]; });
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (down[q.top()] != down[v[i]]) return false;
+		q.pop();
+	}
+	return q.empty();
+}
+
+bool testOtherHeaps()
+{
+	std::vector<int> v;
+	sjtu::dary_heap<int, RankLess> d{ RankLess(down) };
+	sjtu::pairing_heap<int, RankLess> p{ RankLess(down) };
+	sjtu::minmax_heap<int, RankLess> m{ RankLess(down) };
+	sjtu::bounded_priority_queue<int, 50, RankLess> b{ RankLess(down) };
+	sjtu::external_priority_queue<int, RankLess> e(256, 4, RankLess(down));
+	sjtu::concurrent_priority_queue<int, RankLess> c(1, RankLess(down));
+	for (int i = 0; i < 300; ++i) {
+		int x = rand() % ids;
+		d.push(x); p.push(x); m.push(x); b.push(x); e.push(x); c.push(x);
+		v.push_back(x);
+	}
+	if (!heapPopsBy(d, v) || !heapPopsBy(p, v)) return false;
+	sjtu::dary_heap<int, RankLess> r(v.begin(), v.end(), RankLess(down));
+	if (!heapPopsBy(r, v)) return false;
+	std::sort(v.begin(), v.end(), [&](int a, int b) { return down[a] > down[b]; });
+	for (size_t i = 0; i < v.size(); ++i) {
+		if (down[m.top_max()] != down[v[i]] || down[e.top()] != down[v[i]]) return false;
+		m.pop_max(); e.pop();
+	}
+	std::vector<int> kept;
+	b.drain_sorted(kept);
+	for (size_t i = 0; i < kept.size(); ++i)
+		if (down[kept[i]] != down[v[i]]) return false;
+	// try_pop compares the tops of two heaps with the stored comparator
+	int out, cnt = 0;
+	while (c.try_pop(out)) ++cnt;
+	return kept.size() == 50 && cnt == 300 && m.empty() && e.empty()
+		&& b.value_comp().rank == down && c.value_comp().rank == down;
+}
+
+bool testEmptyBase()
+{
+	// std::less takes no room, a stateful Compare only its own
+	return sizeof(sjtu::priority_queue<int>) + sizeof(RankLess) == sizeof(Queue);
+}
+
+int main()
+{
+	for (int i = 0; i < ids; ++i) {
+		up[i] = rand() % 1000;
+		down[i] = -up[i];
+	}
+	std::cout << (testStored() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRange() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStable() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testPersistent() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testOtherHeaps() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testEmptyBase() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
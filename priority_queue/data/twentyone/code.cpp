@@ -0,0 +1,169 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "priority_queue.hpp"
+#include "dary_heap.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827);
+}
+
+template<class Queue>
+bool samePops(Queue a, Queue b)
+{
+	if (a.size() != b.size()) return false;
+	while (!a.empty()) {
+		if (a.top() != b.top()) return false;
+		a.pop(), b.pop();
+	}
+	return b.empty();
+}
+
+template<class Queue>
+bool testRoundTrip()
+{
+	Queue q;
+	for (int i = 0; i < 200000; i++) q.push(rand());
+	for (int i = 0; i < 50000; i++) q.pop();
+	std::stringstream ss;
+	q.save(ss);
+	Queue r;
+	r.push(5);
+	r.load(ss);
+	if (!samePops(q, r)) return false;
+	// the loaded queue goes on like the original
+	for (int i = 0; i < 1000; i++) {
+		int x = rand();
+		q.push(x), r.push(x);
+	}
+	if (!samePops(q, r)) return false;
+	std::stringstream empty;
+	Queue e;
+	e.save(empty);
+	r.load(empty);
+	return r.empty();
+}
+
+struct Task {
+	int prio, id;
+	bool operator!=(const Task &o) const {
+		return prio != o.prio || id != o.id;
+	}
+};
+struct ByPrio {
+	bool operator()(const Task &a, const Task &b) const {
+		return a.prio < b.prio;
+	}
+};
+
+bool testStable()
+{
+	typedef sjtu::priority_queue<Task, ByPrio, true> Stable;
+	Stable q;
+	for (int i = 0; i < 10000; i++) q.push(Task{ rand() & 7, i });
+	std::stringstream ss;
+	q.save(ss);
+	Stable r;
+	r.load(ss);
+	for (int i = 0; i < 100; i++) q.push(Task{ i & 7, -i }), r.push(Task{ i & 7, -i });
+	return samePops(q, r);
+}
+
+bool testRejects()
+{
+	sjtu::priority_queue<int> q;
+	for (int i = 0; i < 1000; i++) q.push(i);
+	std::stringstream ss;
+	q.save(ss);
+	std::string full = ss.str();
+	// another container, another arity, a cut-off stream
+	sjtu::dary_heap<int> d;
+	sjtu::dary_heap<int, std::less<int>, 2> d2;
+	d.push(1);
+	std::stringstream s1(full), s2, s3(full.substr(0, full.size() - 3));
+	d.save(s2);
+	try {
+		d.load(s1);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	try {
+		d2.load(s2);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	sjtu::priority_queue<int> r;
+	try {
+		r.load(s3);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	return d.size() == 1 && d.top() == 1 && r.empty();
+}
+
+// a snapshot of the right size whose ranks lie: a right spine of 300
+// nodes that all claim rank 1, each with a leaf on its left
+bool testBadRanks()
+{
+	const int spine = 300, cnt = 2 * spine + 1;
+	sjtu::priority_queue<int> q;
+	for (int i = 0; i < cnt; i++) q.push(i);
+	std::stringstream ss;
+	q.save(ss);
+	std::string s = ss.str();
+	size_t at = sizeof(sjtu::snapshot_header);
+	for (int i = 0; i < cnt; i++, at += sizeof(int) + 1) {
+		int v = cnt - i;
+		std::memcpy(&s[at], &v, sizeof(int));
+		s[at + sizeof(int)] = i < 2 * spine && i % 2 == 0 ? (char)0x81 : 0;
+	}
+	std::stringstream bad(s);
+	sjtu::priority_queue<int> r;
+	try {
+		r.load(bad);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	if (!r.empty()) return false;
+	sjtu::priority_queue<int> other;
+	for (int i = 0; i < 1000; i++) other.push(-i);
+	r.merge(other);
+	return r.size() == 1000 && r.top() == 0;
+}
+
+// a header that claims far more records than there are
+template<class Queue>
+bool testBadCount()
+{
+	Queue q;
+	q.push(1);
+	std::stringstream ss;
+	q.save(ss);
+	std::string s = ss.str();
+	sjtu::snapshot_header h;
+	std::memcpy(&h, s.data(), sizeof(h));
+	unsigned long long counts[] = { 1ull << 62, 1ull << 40, ~0ull };
+	for (unsigned long long c : counts) {
+		h.count = c;
+		std::memcpy(&s[0], &h, sizeof(h));
+		std::stringstream bad(s);
+		Queue r;
+		try {
+			r.load(bad);
+			return false;
+		} catch (sjtu::runtime_error &) {}
+	}
+	return true;
+}
+
+int main()
+{
+	std::cout << (testRoundTrip<sjtu::priority_queue<int>>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRoundTrip<sjtu::dary_heap<int>>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testStable() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testRejects() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBadRanks() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBadCount<sjtu::priority_queue<int>>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBadCount<sjtu::dary_heap<int>>() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+#include <cstdio>
+#include <set>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+bool testPersistent()
+{
+	typedef sjtu::persistent_priority_queue<int> pq;
+	const int V = 3000;
+	static pq version[V];
+	static std::multiset<int> expect[V];
+	for (int i = 1; i < V; ++i) {
+		int from = rand() % i, op = rand() % 4;
+		if (op == 0 && !version[from].empty()) {
+			version[i] = version[from].pop();
+			expect[i] = expect[from];
+			expect[i].erase(--expect[i].end());
+		} else if (op == 1) {
+			int other = rand() % i;
+			version[i] = version[from].merge(version[other]);
+			expect[i] = expect[from];
+			expect[i].insert(expect[other].begin(), expect[other].end());
+		} else {
+			int x = rand() % 100000;
+			version[i] = version[from].push(x);
+			expect[i] = expect[from];
+			expect[i].insert(x);
+		}
+	}
+	for (int i = 0; i < V; ++i) {
+		if (version[i].size() != expect[i].size()) return false;
+		if (!expect[i].empty() && version[i].top() != *expect[i].rbegin()) return false;
+	}
+	// drain a copy of the largest version, the original must not change
+	int big = 0;
+	for (int i = 0; i < V; ++i) if (expect[i].size() > expect[big].size()) big = i;
+	pq q = version[big];
+	for (auto it = expect[big].rbegin(); it != expect[big].rend(); ++it) {
+		if (q.top() != *it) return false;
+		q = q.pop();
+	}
+	return q.empty() && version[big].size() == expect[big].size();
+}
+
+// merging a version into its own descendant doubles it without copying;
+// the size must stop at a size_t instead of wrapping past empty()
+bool testSelfMerge()
+{
+	typedef sjtu::persistent_priority_queue<int> pq;
+	pq q;
+	for (int i = 0; i < 8; ++i) q = q.push(i);
+	int grown = 0;
+	for (int i = 0; i < 300; ++i) {
+		try {
+			q = q.merge(q.push(i));
+			++grown;
+		} catch (sjtu::runtime_error &) {
+			break;
+		}
+	}
+	if (grown < 32 || grown == 300) return false;
+	try {
+		pq r = q.merge(q);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	if (q.empty() || q.size() < (size_t(-1) >> 2)) return false;
+	if (q.top() != grown - 1) return false;
+	pq r = q.pop();
+	return r.size() == q.size() - 1 && r.top() == grown - 2;
+}
+
+int main()
+{
+	std::cout << (testPersistent() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testSelfMerge() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+#include <cstdio>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+// counts every call, to check the counters against
+unsigned long long calls = 0;
+
+struct Counting {
+	bool operator()(int a, int b) const {
+		++calls;
+		return a < b;
+	}
+};
+
+typedef sjtu::priority_queue<int, Counting, false, true> Queue;
+typedef sjtu::priority_queue<int, Counting, true, true> StableQueue;
+
+template<class Q>
+bool testCounters()
+{
+	Q q;
+	calls = 0;
+	int pushes = 0, pops = 0;
+	for (int i = 0; i < 20000; ++i) {
+		if (rand() % 3 || q.empty()) {
+			q.push(rand() % 1000);
+			++pushes;
+		} else {
+			if (i & 1) q.pop();
+			else q.pop_value();
+			++pops;
+		}
+	}
+	const sjtu::heap_stats &s = q.stats();
+	if (s.comparisons != calls) return false;
+	if (s.allocations != (unsigned long long)pushes || !s.slabs) return false;
+	if (s.merges != (unsigned long long)(pushes + pops) || s.pops != (unsigned long long)pops) return false;
+	// unstable, a merge compares once per node on its path
+	if (s.mergePath > s.comparisons || s.longestPath > s.mergePath) return false;
+	unsigned long long bucketed = 0;
+	for (int b = 0; b < sjtu::heap_stats::popBuckets; ++b) bucketed += s.popCost[b];
+	if (bucketed != s.pops) return false;
+	// ranks stay below log2(n + 1)
+	if ((1ull << s.maxRank) > (unsigned long long)pushes + 1) return false;
+	// to_sorted_vector compares too, and a copy starts afresh
+	std::vector<int> v;
+	unsigned long long before = s.comparisons;
+	q.to_sorted_vector(v);
+	if (s.comparisons <= before || s.comparisons != calls) return false;
+	Q c(q);
+	if (c.stats().comparisons || c.stats().allocations != q.size()) return false;
+	q.reset_stats();
+	return !s.comparisons && !s.merges && !s.pops && !s.maxRank;
+}
+
+bool testUnstablePath()
+{
+	Queue q;
+	calls = 0;
+	for (int i = 0; i < 5000; ++i) q.push(rand());
+	for (int i = 0; i < 1000; ++i) q.pop();
+	return q.stats().mergePath == q.stats().comparisons;
+}
+
+bool testLayout()
+{
+	// without stats mode the counters take no room
+	return sizeof(sjtu::priority_queue<int>) + sizeof(sjtu::heap_stats) == sizeof(sjtu::priority_queue<int, std::less<int>, false, true>)
+		&& sizeof(sjtu::priority_queue<int>) == sizeof(sjtu::priority_queue<int, Counting>);
+}
+
+int main()
+{
+	std::cout << (testCounters<Queue>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testCounters<StableQueue>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testUnstablePath() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testLayout() ? "OKAY" : "FAIL") << std::endl;
+	Queue q;
+	for (int i = 0; i < 1000; ++i) q.push(rand() % 1000);
+	for (int i = 0; i < 300; ++i) q.pop();
+	q.dump_stats(std::cout);
+	return 0;
+}
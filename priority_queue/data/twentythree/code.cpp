@@ -0,0 +1,93 @@
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+
+#include "priority_queue.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+// throws on the fuse-th comparison from now, wherever in a merge that is
+int fuse = -1;
+
+struct Fragile {
+	bool operator()(int a, int b) const {
+		if (fuse >= 0 && fuse-- == 0) throw sjtu::runtime_error();
+		return a < b;
+	}
+};
+
+typedef sjtu::priority_queue<int, Fragile> Queue;
+
+// the queue holds exactly v, and its nodes are still a valid heap
+bool holds(const Queue &q, std::vector<int> v)
+{
+	if (q.size() != v.size()) return false;
+	Queue c(q);
+	std::sort(v.begin(), v.end());
+	for (int i = (int)v.size() - 1; i >= 0; --i) {
+		if (c.top() != v[i]) return false;
+		c.pop();
+	}
+	return c.empty();
+}
+
+// arm the fuse at every possible comparison of op until op gets through;
+// after each throw both queues must be exactly as before
+template<class Op>
+bool everyFuse(Queue &a, std::vector<int> &va, Queue &b, std::vector<int> &vb, Op op)
+{
+	for (int f = 0;; ++f) {
+		fuse = f;
+		try {
+			op();
+			fuse = -1;
+			return true;
+		} catch (sjtu::runtime_error &) {
+			fuse = -1;
+			if (!holds(a, va) || !holds(b, vb)) return false;
+		}
+	}
+}
+
+bool testStrong()
+{
+	Queue a, b;
+	std::vector<int> va, vb;
+	for (int round = 0; round < 200; ++round) {
+		int x = rand() % 1000;
+		if (!everyFuse(a, va, b, vb, [&]() { a.push(x); })) return false;
+		va.push_back(x);
+		if (round % 3 == 0) {
+			int y = rand() % 1000;
+			if (!everyFuse(a, va, b, vb, [&]() { b.push(y); })) return false;
+			vb.push_back(y);
+		}
+		if (round % 5 == 4) {
+			int t = 0;
+			if (!everyFuse(a, va, b, vb, [&]() { t = a.pop_value(); })) return false;
+			va.erase(std::max_element(va.begin(), va.end()));
+			if (!everyFuse(a, va, b, vb, [&]() { a.pop(); })) return false;
+			va.erase(std::max_element(va.begin(), va.end()));
+		}
+		if (round % 50 == 49) {
+			std::vector<int> w;
+			for (int k = 0; k < 20; ++k) w.push_back(rand() % 1000);
+			if (!everyFuse(a, va, b, vb, [&]() { b.push_range(w.begin(), w.end()); })) return false;
+			vb.insert(vb.end(), w.begin(), w.end());
+			if (!everyFuse(a, va, b, vb, [&]() { a.merge(b); })) return false;
+			va.insert(va.end(), vb.begin(), vb.end());
+			vb.clear();
+		}
+	}
+	return holds(a, va) && holds(b, vb);
+}
+
+int main()
+{
+	std::cout << (testStrong() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
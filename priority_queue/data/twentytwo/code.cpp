@@ -0,0 +1,95 @@
+#include <iostream>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "simulation.hpp"
+
+int rand() {
+	static int reed = 1727417277;
+	return (reed += (reed << 5) + 172741827) & 0x7fffffff;
+}
+
+// every callback logs its id, schedules up to two more events at random
+// later (or equal) times and cancels a random pending one; the expected
+// order comes from a std::map keyed by (time, scheduling order)
+template<class Events>
+bool testAgainstMap()
+{
+	typedef sjtu::event_simulation<Events> Sim;
+	typedef std::pair<unsigned long long, int> Key;
+	Sim sim;
+	std::map<Key, int> pending;
+	std::vector<typename Sim::event_id> ids;
+	std::vector<Key> keyOf;
+	std::vector<int> log;
+	int order = 0;
+	std::function<void(unsigned long long)> add = [&](unsigned long long at) {
+		int id = (int)ids.size();
+		keyOf.push_back(Key(at, order++));
+		pending[keyOf.back()] = id;
+		ids.push_back(sim.schedule(at, [&, id]() {
+			log.push_back(id);
+			pending.erase(keyOf[id]);
+			for (int k = rand() % 3; k > 0; --k)
+				if (ids.size() < 200000) add(sim.now() + rand() % 50);
+			int victim = rand() % (int)ids.size();
+			if (sim.cancel(ids[victim]) != (pending.count(keyOf[victim]) == 1)) throw sjtu::runtime_error();
+			pending.erase(keyOf[victim]);
+		}));
+	};
+	for (int i = 0; i < 1000; ++i) add(rand() % 100);
+	for (unsigned long long t = 0; !sim.empty(); t += 37) {
+		sim.run_until(t);
+		if (sim.now() != t || sim.size() != pending.size()) return false;
+		if (!pending.empty() && pending.begin()->first.first <= t) return false;
+	}
+	// ids are handed out in scheduling order, so the map order of the
+	// run events is (time, id): check the log against that
+	for (size_t i = 1; i < log.size(); ++i)
+		if (keyOf[log[i - 1]] > keyOf[log[i]]) return false;
+	return log.size() > 1000;
+}
+
+template<class Events>
+bool testBatchAndThrow()
+{
+	sjtu::event_simulation<Events> sim(10);
+	std::vector<int> log;
+	typename sjtu::event_simulation<Events>::event_id later;
+	sim.schedule(20, [&]() {
+		log.push_back(1);
+		sim.schedule(20, [&]() { log.push_back(4); });
+		sim.cancel(later);
+	});
+	sim.schedule(20, [&]() {
+		log.push_back(2);
+		throw sjtu::runtime_error();
+	});
+	later = sim.schedule(20, [&]() { log.push_back(99); });
+	sim.schedule(20, [&]() { log.push_back(3); });
+	try {
+		sim.run_until(100);
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	if (sim.now() != 20 || sim.size() != 2) return false;
+	if (sim.run_until(100) != 2 || sim.now() != 100 || !sim.empty()) return false;
+	try {
+		sim.schedule(99, []() {});
+		return false;
+	} catch (sjtu::runtime_error &) {}
+	std::vector<int> expect = { 1, 2, 3, 4 };
+	return log == expect;
+}
+
+int main()
+{
+	std::cout << (testAgainstMap<sjtu::wheel_events>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testAgainstMap<sjtu::pairing_events>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testAgainstMap<sjtu::leftist_events>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBatchAndThrow<sjtu::wheel_events>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBatchAndThrow<sjtu::pairing_events>() ? "OKAY" : "FAIL") << std::endl;
+	std::cout << (testBatchAndThrow<sjtu::leftist_events>() ? "OKAY" : "FAIL") << std::endl;
+	return 0;
+}
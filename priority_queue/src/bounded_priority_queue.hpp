@@ -0,0 +1,162 @@
+#ifndef SJTU_BOUNDED_PRIORITY_QUEUE_HPP
+#define SJTU_BOUNDED_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "priority_queue.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+  /**
+   * keeps the K elements that a priority_queue<T, Compare> would pop
+   * first, out of a stream of any length, in O(K) memory.
+   * it is a binary heap turned upside down: the worst element kept, the
+   * boundary, sits at the root, so an element that cannot make it is
+   * turned away after a single comparison.
+   * the heap only ever allocates once, K slots on the first push.
+   */
+  template<typename T, size_t K, class Compare = std::less<T>>
+  class bounded_priority_queue : private CompareHolder<Compare> {
+    static_assert(K > 0, "a bounded queue must hold at least one element");
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    heap_array<T> arr;
+    static const int maxDepth = 64;
+    /**
+     * number of levels e climbs from the fresh leaf at arr.size().
+     */
+    int climb(const T& e) const {
+      int len = 0;
+      for (size_t i = arr.size(); i; i = (i - 1) / 2, ++len)
+        if (!comp()(e, arr[(i - 1) / 2])) break;
+      return len;
+    }
+    /**
+     * the chain of children e sinks through when it replaces the root of
+     * the first n slots.
+     */
+    int sink(const T& e, size_t n, size_t* path) const {
+      int len = 0;
+      for (size_t i = 0;;) {
+        size_t c = i * 2 + 1;
+        if (c >= n) break;
+        if (c + 1 < n && comp()(arr[c + 1], arr[c])) ++c;
+        if (!comp()(arr[c], e)) break;
+        path[len++] = i = c;
+      }
+      return len;
+    }
+    /**
+     * move the children along path one level up, return the hole.
+     */
+    size_t shift(const size_t* path, int len) {
+      size_t hole = 0;
+      for (int k = 0; k < len; ++k) {
+        arr[hole] = std::move(arr[path[k]]);
+        hole = path[k];
+      }
+      return hole;
+    }
+    template<class U>
+    bool insert(U&& e) {
+      if (arr.size() == K) {
+        if (!comp()(arr[0], e)) return false;
+        size_t path[maxDepth];
+        int len = sink(e, K, path);
+        arr[shift(path, len)] = std::forward<U>(e);
+        return true;
+      }
+      arr.reserve(K);
+      int len = climb(e);
+      if (!len) {
+        arr.push_back(std::forward<U>(e));
+        return true;
+      }
+      size_t i = arr.size();
+      arr.push_back(std::move(arr[(i - 1) / 2]));
+      for (i = (i - 1) / 2; --len; i = (i - 1) / 2) arr[i] = std::move(arr[(i - 1) / 2]);
+      arr[i] = std::forward<U>(e);
+      return true;
+    }
+  public:
+    /**
+     * constructors
+     */
+    bounded_priority_queue() : Holder(Compare()) {}
+    explicit bounded_priority_queue(const Compare& c) : Holder(c) {}
+    /**
+     * the comparator the queue orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * offer an element to the queue.
+     * @return whether it is kept, possibly pushing out the boundary.
+     */
+    bool push(const T& e) {
+      return insert(e);
+    }
+    bool push(T&& e) {
+      return insert(std::move(e));
+    }
+    /**
+     * the worst element kept, the one the next better element replaces.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& boundary() const {
+      if (arr.empty()) throw(container_is_empty());
+      return arr[0];
+    }
+    /**
+     * delete the boundary element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      pop_value();
+    }
+    T pop_value() {
+      if (arr.empty()) throw(container_is_empty());
+      size_t last = arr.size() - 1, path[maxDepth];
+      int len = sink(arr[last], last, path);
+      T res(std::move(arr[0]));
+      size_t hole = shift(path, len);
+      if (last) arr[hole] = std::move(arr[last]);
+      arr.pop_back();
+      return res;
+    }
+    /**
+     * move all elements to the back of out, best first, and clear.
+     * out needs push_back, size and operator[].
+     * if Compare throws, the elements moved so far stay in out.
+     */
+    template<class Container>
+    void drain_sorted(Container& out) {
+      size_t base = out.size();
+      while (!arr.empty()) out.push_back(pop_value());
+      for (size_t i = base, j = out.size(); i + 1 < j; ++i, --j) std::swap(out[i], out[j - 1]);
+      arr.release();
+    }
+    size_t size() const {
+      return arr.size();
+    }
+    bool empty() const {
+      return arr.empty();
+    }
+    bool full() const {
+      return arr.size() == K;
+    }
+    static size_t capacity() {
+      return K;
+    }
+    void clear() {
+      arr.release();
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+#define SJTU_CONCURRENT_PRIORITY_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "dary_heap.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+  /**
+   * a relaxed concurrent priority queue (the MultiQueue of Rihani,
+   * Sanders and Dementiev): C * threads independent heaps, each behind
+   * its own try-lock. push goes to a random heap; try_pop looks at two
+   * random heaps and takes the better top. nobody ever waits on a lock,
+   * a busy heap is simply skipped, so throughput grows with the number
+   * of threads at the price of popping an element that is only close to
+   * the best one.
+   * this is the one header that needs <atomic>, it is not used by the
+   * other containers.
+   * every heap keeps a copy of the Compare given to the constructor.
+   */
+  template<typename T, class Compare = std::less<T>, size_t C = 2>
+  class concurrent_priority_queue : private CompareHolder<Compare> {
+    static_assert(C >= 1, "need at least one heap per thread");
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    /**
+     * padded so that two shards never share a cache line; alignas would
+     * need the aligned operator new of C++17.
+     */
+    struct Shard {
+      std::atomic_flag busy;
+      dary_heap<T, Compare> heap;
+      char pad[64];
+      Shard() {
+        busy.clear();
+      }
+      bool try_lock() {
+        return !busy.test_and_set(std::memory_order_acquire);
+      }
+      void unlock() {
+        busy.clear(std::memory_order_release);
+      }
+    };
+    Shard* shard;
+    size_t shards;
+    std::atomic<size_t> n;
+    /**
+     * xorshift per thread, seeded from the address of its state.
+     */
+    static size_t pick(size_t bound) {
+      static thread_local unsigned long long s = 0;
+      if (!s) s = (unsigned long long)&s * 0x9e3779b97f4a7c15ull | 1;
+      s ^= s << 13;
+      s ^= s >> 7;
+      s ^= s << 17;
+      return (size_t)(s % bound);
+    }
+    Shard& lockRandom() {
+      for (;;) {
+        Shard& s = shard[pick(shards)];
+        if (s.try_lock()) return s;
+      }
+    }
+    template<class U>
+    void insert(U&& e) {
+      Shard& s = lockRandom();
+      try {
+        s.heap.push(std::forward<U>(e));
+      }
+      catch (...) {
+        s.unlock();
+        throw;
+      }
+      // count before the element can be seen, so n never drops below
+      // the real number of elements
+      n.fetch_add(1, std::memory_order_relaxed);
+      s.unlock();
+    }
+    bool take(Shard& s, T& out) {
+      try {
+        out = s.heap.pop_value();
+      }
+      catch (...) {
+        s.unlock();
+        throw;
+      }
+      s.unlock();
+      n.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  public:
+    /**
+     * @param threads the number of threads expected to use the queue.
+     */
+    explicit concurrent_priority_queue(size_t threads, const Compare& c = Compare()) :
+      Holder(c), shards(C * (threads ? threads : 1)), n(0) {
+      shard = new Shard[shards];
+      try {
+        for (size_t i = 0; i < shards; ++i) shard[i].heap = dary_heap<T, Compare>(c);
+      }
+      catch (...) {
+        delete[] shard;
+        throw;
+      }
+    }
+    concurrent_priority_queue(const concurrent_priority_queue&) = delete;
+    concurrent_priority_queue& operator=(const concurrent_priority_queue&) = delete;
+    ~concurrent_priority_queue() {
+      delete[] shard;
+    }
+    /**
+     * the comparator the queue orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * push new element, thread-safe.
+     */
+    void push(const T& e) {
+      insert(e);
+    }
+    void push(T&& e) {
+      insert(std::move(e));
+    }
+    /**
+     * move one of the best elements into out, thread-safe.
+     * @return false if every heap was seen empty.
+     */
+    bool try_pop(T& out) {
+      for (int attempt = 0; n.load(std::memory_order_relaxed); ++attempt) {
+        size_t i = pick(shards);
+        Shard& a = shard[i];
+        if (!a.try_lock()) continue;
+        if (shards == 1) {
+          if (!a.heap.empty()) return take(a, out);
+          a.unlock();
+          continue;
+        }
+        // always a second, different heap: taking a unchecked when b is
+        // busy would fall back to one choice, whose rank error is unbounded
+        size_t j = pick(shards - 1);
+        Shard& b = shard[j < i ? j : j + 1];
+        if (!b.try_lock()) {
+          a.unlock();
+          continue;
+        }
+        bool useB;
+        try {
+          useB = a.heap.empty() ||
+            (!b.heap.empty() && comp()(a.heap.top(), b.heap.top()));
+        }
+        catch (...) {
+          a.unlock(); b.unlock();
+          throw;
+        }
+        Shard& best = useB ? b : a;
+        (useB ? a : b).unlock();
+        if (!best.heap.empty()) return take(best, out);
+        best.unlock();
+        // the counter says there is something; after a while of random
+        // misses, sweep every heap once before trying again
+        if (attempt >= 16) {
+          for (size_t i = 0; i < shards; ++i) {
+            if (!shard[i].try_lock()) continue;
+            if (!shard[i].heap.empty()) return take(shard[i], out);
+            shard[i].unlock();
+          }
+          attempt = 0;
+        }
+      }
+      return false;
+    }
+    /**
+     * the number of elements, exact only when no one else is working.
+     */
+    size_t size() const {
+      return n.load(std::memory_order_relaxed);
+    }
+    bool empty() const {
+      return !size();
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,316 @@
+#ifndef SJTU_DARY_HEAP_HPP
+#define SJTU_DARY_HEAP_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "priority_queue.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+  /**
+   * an implicit D-ary heap kept in one contiguous array.
+   * same interface and ordering as priority_queue (the largest element
+   * under Compare is on top), for queues that never need a cheap merge:
+   * no per-node allocation and no pointer chasing.
+   * every sift decides its whole path before moving anything, so a
+   * throwing Compare leaves the heap untouched.
+   */
+  template<typename T, class Compare = std::less<T>, size_t D = 4>
+  class dary_heap : private CompareHolder<Compare> {
+    static_assert(D >= 2, "a heap needs at least two children per node");
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    heap_array<T> arr;
+    /**
+     * longest root-to-leaf path of any heap that fits in memory.
+     */
+    static const int maxDepth = 64;
+    static size_t parent(size_t i) {
+      return (i - 1) / D;
+    }
+    static size_t child(size_t i) {
+      return i * D + 1;
+    }
+    /**
+     * number of levels e has to climb from the fresh leaf at arr.size().
+     */
+    int climb(const T& e) const {
+      int len = 0;
+      for (size_t i = arr.size(); i; i = parent(i), ++len)
+        if (!comp()(arr[parent(i)], e)) break;
+      return len;
+    }
+    /**
+     * the chain of children the element at index last sinks through when
+     * it replaces the root, ignoring last itself.
+     */
+    int sink(size_t last, size_t* path) const {
+      int len = 0;
+      const T& e = arr[last];
+      for (size_t i = 0;;) {
+        size_t c = child(i);
+        if (c >= last) break;
+        size_t best = c, stop = c + D < last ? c + D : last;
+        for (size_t k = c + 1; k < stop; ++k)
+          if (comp()(arr[best], arr[k])) best = k;
+        if (!comp()(e, arr[best])) break;
+        path[len++] = i = best;
+      }
+      return len;
+    }
+    /**
+     * shift the len ancestors of the fresh leaf one level down, in a slot
+     * already reserved; return the hole at the top of the chain.
+     */
+    size_t raise(int len) {
+      size_t i = arr.size();
+      arr.push_back(std::move(arr[parent(i)]));
+      for (i = parent(i); --len; i = parent(i)) arr[i] = std::move(arr[parent(i)]);
+      return i;
+    }
+    /**
+     * move the children along path up and the last element into the hole,
+     * then drop the last slot; the old root must be dealt with already.
+     */
+    void fill(const size_t* path, int len) {
+      size_t last = arr.size() - 1;
+      if (last) {
+        size_t hole = 0;
+        for (int k = 0; k < len; ++k) {
+          arr[hole] = std::move(arr[path[k]]);
+          hole = path[k];
+        }
+        arr[hole] = std::move(arr[last]);
+      }
+      arr.pop_back();
+    }
+    /**
+     * restore the heap property of the subtree at i, children already heaps.
+     */
+    void siftDown(size_t i) {
+      size_t n = arr.size();
+      for (;;) {
+        size_t c = child(i);
+        if (c >= n) return;
+        size_t best = c, stop = c + D < n ? c + D : n;
+        for (size_t k = c + 1; k < stop; ++k)
+          if (comp()(arr[best], arr[k])) best = k;
+        if (!comp()(arr[i], arr[best])) return;
+        std::swap(arr[i], arr[best]);
+        i = best;
+      }
+    }
+    /**
+     * Floyd's bottom-up construction, O(n).
+     */
+    void heapify() {
+      if (arr.size() < 2) return;
+      for (size_t i = parent(arr.size() - 1) + 1; i--;) siftDown(i);
+    }
+  public:
+    /**
+     * constructors
+     */
+    dary_heap() : Holder(Compare()) {}
+    explicit dary_heap(const Compare& c) : Holder(c) {}
+    dary_heap(const dary_heap& other) : Holder(other), arr(other.arr) {}
+    /**
+     * build from a range in O(n).
+     */
+    template<class InputIterator>
+    dary_heap(InputIterator first, InputIterator last, const Compare& c = Compare()) : Holder(c) {
+      push_range(first, last);
+    }
+    /**
+     * deconstructor
+     */
+    ~dary_heap() {}
+    /**
+     * Assignment operator
+     */
+    dary_heap& operator=(const dary_heap& other) {
+      arr = other.arr;
+      Holder::operator=(other);
+      return (*this);
+    }
+    /**
+     * the comparator the heap orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * get the top of the queue.
+     * @return a reference of the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top() const {
+      if (arr.empty()) throw(container_is_empty());
+      return arr[0];
+    }
+    /**
+     * push new element to the priority queue.
+     */
+    void push(const T& e) {
+      if (arr.owns(&e)) {
+        // e.g. push(top()): copy it out before the array moves
+        T copy(e);
+        push(std::move(copy));
+        return;
+      }
+      arr.reserve(arr.size() + 1);
+      int len = climb(e);
+      if (!len) arr.push_back(e);
+      else arr[raise(len)] = e;
+    }
+    void push(T&& e) {
+      if (arr.owns(&e)) {
+        T copy(std::move(e));
+        push(std::move(copy));
+        return;
+      }
+      arr.reserve(arr.size() + 1);
+      int len = climb(e);
+      if (!len) arr.push_back(std::move(e));
+      else arr[raise(len)] = std::move(e);
+    }
+    /**
+     * the element is built once and then moved into place.
+     */
+    template<class... Args>
+    void emplace(Args&&... args) {
+      push(T(std::forward<Args>(args)...));
+    }
+    /**
+     * push all elements of [first, last) in O(n + size()): an empty heap
+     * is heapified in place, otherwise the range is merged in.
+     * if Compare throws, none of them is pushed.
+     */
+    template<class InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+      if (!arr.empty()) {
+        dary_heap tmp(first, last, comp());
+        merge(tmp);
+        return;
+      }
+      try {
+        for (; first != last; ++first) arr.push_back(*first);
+        heapify();
+      }
+      catch (...) {
+        arr.clear();
+        throw;
+      }
+    }
+    /**
+     * delete the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (arr.empty()) throw(container_is_empty());
+      size_t path[maxDepth];
+      fill(path, sink(arr.size() - 1, path));
+    }
+    /**
+     * delete the top element and hand it out, moved rather than copied.
+     * throw container_is_empty if empty() returns true;
+     */
+    T pop_value() {
+      if (arr.empty()) throw(container_is_empty());
+      size_t path[maxDepth];
+      int len = sink(arr.size() - 1, path);
+      T res(std::move(arr[0]));
+      fill(path, len);
+      return res;
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return arr.size();
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return arr.empty();
+    }
+    void clear() {
+      arr.release();
+    }
+    /**
+     * make room for exactly cnt elements in one allocation.
+     */
+    void reserve(size_t cnt) {
+      arr.reserve_exact(cnt);
+    }
+    size_t capacity() const {
+      return arr.capacity();
+    }
+    /**
+     * merge two heaps in O(n + m) by heapifying the concatenation.
+     * clear the other heap.
+     * the heapify runs on a scratch array, so a throwing Compare leaves
+     * both heaps as they were.
+     */
+    void merge(dary_heap& other) {
+      if (&other == this || other.arr.empty()) return;
+      heap_array<T> tmp;
+      tmp.reserve(arr.size() + other.arr.size());
+      for (size_t i = 0; i < arr.size(); ++i) tmp.push_back(arr[i]);
+      for (size_t i = 0; i < other.arr.size(); ++i) tmp.push_back(other.arr[i]);
+      arr.swap(tmp);
+      try {
+        heapify();
+      }
+      catch (...) {
+        arr.swap(tmp);
+        throw;
+      }
+      other.arr.release();
+    }
+    /**
+     * write the array as it is to os, see snapshot_header.
+     * throw runtime_error if os fails.
+     */
+    template<class Stream>
+    void save(Stream& os) const {
+      static_assert(std::is_trivially_copyable<T>::value, "snapshots hold raw bytes");
+      snapshot_writer<Stream> w(os, snapshotKind, sizeof(T), sizeof(T), arr.size(), 0);
+      for (size_t i = 0; i < arr.size(); ++i) w.put(&arr[i], sizeof(T));
+      w.flush();
+    }
+    /**
+     * replace the contents by a snapshot taken with save(): the array
+     * image is copied back in O(n) into one allocation unless it is big,
+     * without a single comparison.
+     * throw runtime_error if is fails or holds something else; the heap
+     * is then left as it was.
+     */
+    template<class Stream>
+    void load(Stream& is) {
+      static_assert(std::is_trivially_copyable<T>::value, "snapshots hold raw bytes");
+      snapshot_reader<Stream> r(is, snapshotKind, sizeof(T), sizeof(T));
+      heap_array<T> tmp;
+      tmp.reserve_exact(snapshotReserve(r.header.count, sizeof(T)));
+      for (size_t i = 0; i < r.header.count; ++i) {
+        T e;
+        std::memcpy(&e, r.get(sizeof(T)), sizeof(T));
+        tmp.push_back(e);
+      }
+      arr.swap(tmp);
+    }
+  private:
+    // the image depends on the arity, so it is part of the kind
+    static const unsigned int snapshotKind = 0x100 + D;
+  };
+
+}
+
+#endif
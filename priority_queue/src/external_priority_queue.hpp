@@ -0,0 +1,359 @@
+#ifndef SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+#define SJTU_EXTERNAL_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "dary_heap.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+  /**
+   * a priority queue that holds more than fits in memory.
+   * new elements go to an in-memory heap; when it is full, its contents
+   * are written out best first as a sorted run to an anonymous temporary
+   * file. top/pop merge the in-memory heap with the heads of all runs,
+   * reading every run sequentially through a buffer of its own, so a run
+   * is only read as far as pops actually reach.
+   * the memory budget covers both: half of it is the in-memory heap, the
+   * other half the buffers of the runs. at most fanIn runs are live; when
+   * another one is needed, the smallest half of them is first merged
+   * into one, so the buffers and open files stay bounded, and since runs
+   * grow geometrically an element is rewritten O(log(n / budget)) times.
+   * elements are written byte for byte, so T must be trivially copyable.
+   * if Compare throws, the operation is abandoned and no element is lost.
+   * file errors throw runtime_error; elements that could not be written or
+   * read back are dropped and no longer counted by size().
+   */
+  template<typename T, class Compare = std::less<T>>
+  class external_priority_queue : private CompareHolder<Compare> {
+    static_assert(std::is_trivially_copyable<T>::value,
+      "external_priority_queue writes elements as raw bytes");
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    class Run {
+    public:
+      FILE* file;
+      size_t left;  // elements in the file not yet buffered
+      T* buf;
+      size_t cap, pos, len;
+      explicit Run(size_t c) : file(nullptr), left(0), buf(nullptr), cap(c), pos(0), len(0) {}
+      ~Run() {
+        if (file) std::fclose(file);
+        ::operator delete(buf);
+      }
+      const T& head() const {
+        return buf[pos];
+      }
+      /**
+       * the elements still to come out of the run.
+       */
+      size_t remaining() const {
+        return left + len - pos;
+      }
+      /**
+       * append e while the run is being built.
+       * @return the number of elements lost if the buffer had to go out.
+       */
+      size_t put(const T& e) {
+        buf[len++] = e;
+        return len == cap ? flush() : 0;
+      }
+      /**
+       * write the buffer out while the run is being built.
+       * @return the number of elements that did not make it to the file.
+       */
+      size_t flush() {
+        size_t done = len ? std::fwrite(buf, sizeof(T), len, file) : 0;
+        size_t lost = len - done;
+        left += done;
+        len = 0;
+        return lost;
+      }
+      /**
+       * refill the buffer once it has been used up.
+       * @return the number of elements that could not be read back.
+       */
+      size_t fill() {
+        if (pos < len || !left) return 0;
+        size_t want = left < cap ? left : cap;
+        size_t got = std::fread(buf, sizeof(T), want, file);
+        size_t lost = got < want ? left - got : 0;
+        left = lost ? 0 : left - want;
+        pos = 0; len = got;
+        return lost;
+      }
+      bool exhausted() const {
+        return pos == len;
+      }
+    };
+    class HeadCompare : private CompareHolder<Compare> {
+    public:
+      explicit HeadCompare(const Compare& c) : CompareHolder<Compare>(c) {}
+      bool operator()(const Run* a, const Run* b) const {
+        return this->comp()(a->head(), b->head());
+      }
+    };
+    dary_heap<T, Compare> mem;
+    // runs are only reordered, never changed, by settle() in top()
+    mutable dary_heap<Run*, HeadCompare> runs;
+    // live runs that Compare kept from entering runs; it always has room
+    // for every live run, so parking one never fails
+    mutable heap_array<Run*> stray;
+    // every live run, wherever it is queued; they are owned here
+    heap_array<Run*> live;
+    size_t limit, bufLen, fanIn, n;
+    static size_t elements(size_t bytes) {
+      return bytes / sizeof(T) ? bytes / sizeof(T) : 1;
+    }
+    /**
+     * a new, empty run with its file and buffer, registered as live.
+     */
+    Run* open() {
+      live.reserve(live.size() + 1);
+      stray.reserve(live.size() + 1);
+      Run* r = new Run(bufLen);
+      try {
+        r->file = std::tmpfile();
+        if (!r->file) throw(runtime_error());
+        r->buf = static_cast<T*>(::operator new(bufLen * sizeof(T)));
+      }
+      catch (...) {
+        delete r;
+        throw;
+      }
+      live.push_back(r);
+      return r;
+    }
+    void drop(Run* r) {
+      size_t i = 0;
+      while (live[i] != r) ++i;
+      live[i] = live[live.size() - 1];
+      live.pop_back();
+      delete r;
+    }
+    /**
+     * hand a run to the merge or, if it has nothing left, drop it.
+     * if Compare throws, the run is parked in stray and the next
+     * top/pop retries, so the exception surfaces there.
+     */
+    void enlist(Run* r) {
+      if (r->exhausted()) {
+        drop(r);
+        return;
+      }
+      try {
+        runs.push(r);
+      }
+      catch (...) {
+        stray.push_back(r);
+      }
+    }
+    /**
+     * move the parked runs into the merge before anything looks at it.
+     */
+    void settle() const {
+      while (!stray.empty()) {
+        runs.push(stray.back());
+        stray.pop_back();
+      }
+    }
+    /**
+     * write the in-memory heap out as a run, best first, merging runs
+     * first if there are fanIn of them already.
+     * if Compare throws halfway, what has been written still becomes a
+     * run and the rest stays in memory.
+     */
+    void spill() {
+      if (live.size() >= fanIn) compact();
+      Run* r = open();
+      size_t lost = 0;
+      try {
+        while (!mem.empty() && !lost) {
+          T e(mem.top());
+          mem.pop();  // compares before it removes anything
+          n -= lost = r->put(e);
+        }
+      }
+      catch (...) {
+        seal(r);
+        throw;
+      }
+      if (seal(r) || lost) throw(runtime_error());
+    }
+    /**
+     * finish writing a run and rewind it for reading.
+     * @return the number of elements lost to a file error.
+     */
+    size_t finish(Run* r) {
+      size_t lost = r->flush();
+      if (r->left && std::fseek(r->file, 0, SEEK_SET) != 0) {
+        lost += r->left;
+        r->left = 0;
+      }
+      lost += r->fill();
+      n -= lost;
+      return lost;
+    }
+    size_t seal(Run* r) {
+      size_t lost = finish(r);
+      enlist(r);
+      return lost;
+    }
+    /**
+     * drop the runs that are used up and park all others in stray, from
+     * where the next top/pop puts them back into the merge; runs and
+     * stray must be empty.
+     */
+    void requeue() {
+      size_t keep = 0;
+      for (size_t i = 0; i < live.size(); ++i) {
+        if (live[i]->exhausted()) delete live[i];
+        else stray.push_back(live[keep++] = live[i]);
+      }
+      while (live.size() > keep) live.pop_back();
+    }
+    /**
+     * merge the smallest half of the live runs, at least two, into one
+     * new run. the merge order is taken apart for it and rebuilt through
+     * stray. if Compare throws, what has been written becomes a run, the
+     * sources keep the rest, and all of them stay live.
+     */
+    void compact() {
+      if (live.size() < 2) return;
+      // fewest elements first; there are only fanIn runs
+      for (size_t i = 1; i < live.size(); ++i)
+        for (size_t j = i; j && live[j]->remaining() < live[j - 1]->remaining(); --j)
+          std::swap(live[j], live[j - 1]);
+      size_t k = live.size() / 2 < 2 ? 2 : live.size() / 2;
+      Run* out = open();
+      runs.clear();
+      stray.clear();
+      size_t lost = 0;
+      try {
+        dary_heap<Run*, HeadCompare> src(runs.value_comp());
+        for (size_t i = 0; i < k; ++i) src.push(live[i]);
+        while (!src.empty() && !lost) {
+          Run* r = src.pop_value();  // compares before it removes anything
+          n -= lost = out->put(r->head());
+          ++r->pos;
+          size_t gone = r->fill();
+          n -= gone;
+          lost += gone;
+          if (!r->exhausted()) src.push(r);
+        }
+      }
+      catch (...) {
+        finish(out);
+        requeue();
+        throw;
+      }
+      lost += finish(out);
+      requeue();
+      if (lost) throw(runtime_error());
+    }
+    bool runOnTop() const {
+      if (runs.empty()) return false;
+      return mem.empty() || comp()(mem.top(), runs.top()->head());
+    }
+  public:
+    /**
+     * @param memoryBytes budget for everything the queue holds in memory:
+     *   half for the in-memory heap, half for the buffers of the fanIn
+     *   runs and the one being written.
+     * @param fanIn the most runs live at once, at least 2; also the most
+     *   temporary files open, plus one while writing.
+     */
+    explicit external_priority_queue(size_t memoryBytes = 64 << 20, size_t fanIn = 16,
+      const Compare& c = Compare()) :
+      Holder(c), mem(c), runs(HeadCompare(c)), limit(elements(memoryBytes / 2)),
+      bufLen(elements(memoryBytes / 2 / ((fanIn < 2 ? 2 : fanIn) + 1))),
+      fanIn(fanIn < 2 ? 2 : fanIn), n(0) {}
+    external_priority_queue(const external_priority_queue&) = delete;
+    external_priority_queue& operator=(const external_priority_queue&) = delete;
+    ~external_priority_queue() {
+      clear();
+    }
+    /**
+     * the comparator the queue orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * get the top of the queue.
+     * @return a reference of the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top() const {
+      if (!n) throw(container_is_empty());
+      settle();
+      return runOnTop() ? runs.top()->head() : mem.top();
+    }
+    /**
+     * push new element to the priority queue.
+     */
+    void push(const T& e) {
+      if (mem.size() >= limit) spill();
+      // grow straight to the budget rather than past it
+      if (mem.size() == mem.capacity() && mem.size() * 2 > limit) mem.reserve(limit);
+      mem.push(e);
+      ++n;
+    }
+    /**
+     * delete the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (!n) throw(container_is_empty());
+      settle();
+      if (!runOnTop()) {
+        mem.pop();
+        --n;
+        return;
+      }
+      Run* r = runs.pop_value();
+      --n;
+      ++r->pos;
+      size_t lost = r->fill();
+      n -= lost;
+      enlist(r);
+      if (lost) throw(runtime_error());
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !n;
+    }
+    /**
+     * the number of runs on disk not yet read to the end, at most fanIn
+     * unless a merge of runs was cut short.
+     */
+    size_t run_count() const {
+      return live.size();
+    }
+    void clear() {
+      for (size_t i = 0; i < live.size(); ++i) delete live[i];
+      live.clear();
+      runs.clear();
+      stray.clear();
+      mem.clear();
+      n = 0;
+    }
+  };
+}
+
+#endif
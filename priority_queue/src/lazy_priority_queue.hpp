@@ -0,0 +1,246 @@
+#ifndef SJTU_LAZY_PRIORITY_QUEUE_HPP
+#define SJTU_LAZY_PRIORITY_QUEUE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+  /**
+   * a leftist heap that merges lazily, for flows which merge or push a
+   * lot and pop little in between. push and merge only append a heap to
+   * a list of pending heaps in O(1) without a comparison; top and pop
+   * first consolidate: the pending heaps are merged pairwise as if taken
+   * from a FIFO queue, round after round, and the result into the main
+   * heap. k pending heaps of n elements in all cost O(k log(n / k)).
+   * consolidation is one merge at a time and each merge is all or
+   * nothing, so if Compare throws there, every element is still in
+   * exactly one heap and the next top or pop goes on from there.
+   */
+  template<typename T, class Compare = std::less<T>>
+  class lazy_priority_queue {
+  public:
+    typedef priority_queue<T, Compare> Heap;
+    typedef typename Heap::Node Node;
+  private:
+    struct Link {
+      Node* heap;
+      Link* next;
+    };
+    // the consolidated heap; its pool holds the nodes of every heap here
+    mutable Heap q;
+    // the pending heaps, oldest first
+    mutable Link* head, * tail;
+    mutable size_t waiting;
+    mutable node_pool<Link> links;
+    size_t n;
+    /**
+     * a fresh link at the end of the list; x must not be null.
+     */
+    void append(Node* x) {
+      Link* l = links.allocate();
+      l->heap = x;
+      l->next = nullptr;
+      if (tail) tail->next = l;
+      else head = l;
+      tail = l;
+      ++waiting;
+    }
+    /**
+     * merge the two oldest pending heaps into the first, which moves to
+     * the end, until one is left; then that one into q.
+     */
+    void consolidate() const {
+      while (head != tail) {
+        Link* a = head, * b = a->next;
+        a->heap = q.mergeNode(a->heap, b->heap);
+        head = b->next;
+        links.deallocate(b);
+        --waiting;
+        if (head) {
+          tail->next = a;
+          a->next = nullptr;
+          tail = a;
+        }
+        else {
+          head = tail = a;
+          a->next = nullptr;
+        }
+      }
+      if (!head) return;
+      q.root = q.mergeNode(q.root, head->heap);
+      links.deallocate(head);
+      head = tail = nullptr;
+      waiting = 0;
+      q.n = n;
+    }
+    void copyFrom(const lazy_priority_queue& other) {
+      for (Link* l = other.head; l; l = l->next) {
+        Link* x = links.allocate();
+        x->heap = nullptr;
+        x->next = nullptr;
+        if (tail) tail->next = x;
+        else head = x;
+        tail = x;
+        ++waiting;
+        q.copy(x->heap, l->heap);
+      }
+      n = other.n;
+    }
+  public:
+    /**
+     * constructors
+     */
+    lazy_priority_queue() : head(nullptr), tail(nullptr), waiting(0), n(0) {}
+    explicit lazy_priority_queue(const Compare& c) :
+      q(c), head(nullptr), tail(nullptr), waiting(0), n(0) {}
+    lazy_priority_queue(const lazy_priority_queue& other) :
+      q(other.q), head(nullptr), tail(nullptr), waiting(0), n(other.q.n) {
+      try {
+        copyFrom(other);
+      }
+      catch (...) {
+        clear();
+        throw;
+      }
+    }
+    /**
+     * deconstructor
+     */
+    ~lazy_priority_queue() {
+      clear();
+    }
+    /**
+     * Assignment operator
+     */
+    lazy_priority_queue& operator=(const lazy_priority_queue& other) {
+      if (&other == this) return (*this);
+      clear();
+      q = other.q;
+      n = other.q.n;
+      copyFrom(other);
+      return (*this);
+    }
+    /**
+     * get the top of the queue, consolidating first.
+     * @return a reference of the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top() const {
+      if (!n) throw(container_is_empty());
+      consolidate();
+      return q.top();
+    }
+    /**
+     * push new element to the priority queue in O(1).
+     */
+    void push(const T& e) {
+      Node* x = q.newNode(e);
+      try {
+        append(x);
+      }
+      catch (...) {
+        q.freeNode(x);
+        throw;
+      }
+      ++n;
+    }
+    void push(T&& e) {
+      Node* x = q.newNode(std::move(e));
+      try {
+        append(x);
+      }
+      catch (...) {
+        q.freeNode(x);
+        throw;
+      }
+      ++n;
+    }
+    /**
+     * delete the top element, consolidating first.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (!n) throw(container_is_empty());
+      consolidate();
+      q.pop();
+      --n;
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !n;
+    }
+    /**
+     * the number of heaps waiting to be consolidated.
+     */
+    size_t pending() const {
+      return waiting;
+    }
+    /**
+     * merge other into this one in O(1) and clear it: its pending heaps
+     * and its main heap join the end of our list, its slabs join ours.
+     * both are assumed to order alike; the comparator of this queue is
+     * the one used.
+     */
+    void merge(lazy_priority_queue& other) {
+      if (&other == this || !other.n) return;
+      if (other.q.root) {
+        // the only step that can throw, so it goes first
+        append(other.q.root);
+        other.q.root = nullptr;
+        other.q.n = 0;
+      }
+      if (other.head) {
+        if (tail) tail->next = other.head;
+        else head = other.head;
+        tail = other.tail;
+        waiting += other.waiting;
+      }
+      n += other.n;
+      other.head = other.tail = nullptr;
+      other.waiting = 0;
+      other.n = 0;
+      q.pool.adopt(other.q.pool);
+      links.adopt(other.links);
+    }
+    /**
+     * merge a priority_queue into this one in O(1) and clear it.
+     */
+    void merge(Heap& other) {
+      if (!other.root) return;
+      append(other.root);
+      n += other.n;
+      other.root = nullptr;
+      other.n = 0;
+      q.pool.adopt(other.pool);
+    }
+    /**
+     * destroy every element and hand all slabs back at once.
+     */
+    void clear() {
+      if (!std::is_trivially_destructible<T>::value)
+        for (Link* l = head; l; l = l->next) q.del(l->heap);
+      head = tail = nullptr;
+      waiting = 0;
+      links.clear();
+      q.clear();
+      n = 0;
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef SJTU_MINMAX_HEAP_HPP
+#define SJTU_MINMAX_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "priority_queue.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+  /**
+   * a double-ended priority queue: the min-max heap of Atkinson et al.
+   * in one array. even levels are ordered like a min-heap and odd levels
+   * like a max-heap (under Compare), so both ends are found in O(1) and
+   * removed in O(log n).
+   * as in dary_heap, every sift works out where things go before moving
+   * anything, so a throwing Compare leaves the heap untouched.
+   */
+  template<typename T, class Compare = std::less<T>>
+  class minmax_heap : private CompareHolder<Compare> {
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    heap_array<T> arr;
+    static const int maxDepth = 64;
+    static size_t parent(size_t i) {
+      return (i - 1) / 2;
+    }
+    static bool minLevel(size_t i) {
+      int level = 0;
+      for (++i; i > 1; i >>= 1) ++level;
+      return !(level & 1);
+    }
+    /**
+     * a goes above b on a level of the given kind.
+     */
+    bool above(const T& a, const T& b, bool min) const {
+      return min ? comp()(a, b) : comp()(b, a);
+    }
+    /**
+     * the chain of slots whose elements shift down one step so that e can
+     * enter at the fresh leaf arr.size().
+     */
+    int climb(const T& e, size_t* chain) const {
+      size_t i = arr.size();
+      int len = 0;
+      if (!i) return 0;
+      bool min = minLevel(i);
+      if (above(e, arr[parent(i)], !min)) {
+        chain[len++] = i = parent(i);
+        min = !min;
+      }
+      while (i > 2 && above(e, arr[parent(parent(i))], min))
+        chain[len++] = i = parent(parent(i));
+      return len;
+    }
+    /**
+     * e replaces the element at hole, on a level of the given kind, and
+     * trickles down among the first n slots. records, level by level,
+     * the slot whose element moves up and whether e then trades places
+     * with the parent of that slot. returns the number of levels.
+     */
+    int trickle(const T& e, size_t hole, size_t n, bool min, size_t* path, bool* trade) const {
+      const T* v = &e;
+      int len = 0;
+      for (size_t i = hole;;) {
+        size_t c = i * 2 + 1;
+        if (c >= n) break;
+        // the best of up to two children and four grandchildren
+        size_t m = c;
+        if (c + 1 < n && above(arr[c + 1], arr[m], min)) m = c + 1;
+        bool grand = false;
+        for (size_t g = c * 2 + 1; g < n && g <= c * 2 + 4; ++g)
+          if (above(arr[g], arr[m], min)) m = g, grand = true;
+        if (!above(arr[m], *v, min)) break;
+        path[len] = m;
+        trade[len] = false;
+        if (!grand) {
+          ++len;
+          break;
+        }
+        if (above(*v, arr[parent(m)], !min)) {
+          trade[len] = true;
+          v = &arr[parent(m)];
+        }
+        ++len;
+        i = m;
+      }
+      return len;
+    }
+    /**
+     * remove the element at hole, a slot on a level of the given kind.
+     */
+    void erase(size_t hole, bool min) {
+      size_t last = arr.size() - 1;
+      if (hole != last) {
+        size_t path[maxDepth];
+        bool trade[maxDepth];
+        int len = trickle(arr[last], hole, last, min, path, trade);
+        T v(std::move(arr[last]));
+        for (int k = 0; k < len; ++k) {
+          arr[hole] = std::move(arr[path[k]]);
+          hole = path[k];
+          if (trade[k]) std::swap(v, arr[parent(hole)]);
+        }
+        arr[hole] = std::move(v);
+      }
+      arr.pop_back();
+    }
+    size_t maxIndex() const {
+      if (arr.size() < 3) return arr.size() - 1;
+      return comp()(arr[1], arr[2]) ? 2 : 1;
+    }
+    template<class U>
+    void insert(U&& e) {
+      if (arr.owns(&e)) {
+        // e.g. push(top_max()): copy it out before the array moves
+        T copy(std::forward<U>(e));
+        insert(std::move(copy));
+        return;
+      }
+      arr.reserve(arr.size() + 1);
+      size_t chain[maxDepth];
+      int len = climb(e, chain);
+      if (!len) {
+        arr.push_back(std::forward<U>(e));
+        return;
+      }
+      arr.push_back(std::move(arr[chain[0]]));
+      for (int k = 1; k < len; ++k) arr[chain[k - 1]] = std::move(arr[chain[k]]);
+      arr[chain[len - 1]] = std::forward<U>(e);
+    }
+  public:
+    /**
+     * constructors
+     */
+    minmax_heap() : Holder(Compare()) {}
+    explicit minmax_heap(const Compare& c) : Holder(c) {}
+    /**
+     * the comparator the heap orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * push new element, O(log n).
+     */
+    void push(const T& e) {
+      insert(e);
+    }
+    void push(T&& e) {
+      insert(std::move(e));
+    }
+    /**
+     * the smallest element under Compare.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top_min() const {
+      if (arr.empty()) throw(container_is_empty());
+      return arr[0];
+    }
+    /**
+     * the largest element under Compare, what priority_queue::top gives.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top_max() const {
+      if (arr.empty()) throw(container_is_empty());
+      return arr[maxIndex()];
+    }
+    /**
+     * delete the smallest element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop_min() {
+      if (arr.empty()) throw(container_is_empty());
+      erase(0, true);
+    }
+    /**
+     * delete the largest element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop_max() {
+      if (arr.empty()) throw(container_is_empty());
+      size_t i = maxIndex();
+      erase(i, i == 0);
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return arr.size();
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return arr.empty();
+    }
+    void clear() {
+      arr.release();
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,446 @@
+#ifndef SJTU_PAIRING_HEAP_HPP
+#define SJTU_PAIRING_HEAP_HPP
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "priority_queue.hpp"
+#include "exceptions.hpp"
+
+namespace sjtu {
+
+  /**
+   * a pairing heap with the interface and ordering of priority_queue.
+   * push and merge are a single link, O(1); pop is the two-pass pairing,
+   * amortized O(log n). nothing recurses, so degenerate shapes (a root
+   * with a million children) are fine.
+   * a Compare that throws leaves the heap with the same elements and the
+   * same top: partially paired trees are hung back under the root.
+   * push hands out a handle which stays valid (also across merge) until
+   * its element is popped or erased; it can be used to change the
+   * element in place or to remove it.
+   */
+  template<typename T, class Compare = std::less<T>>
+  class pairing_heap : private CompareHolder<Compare> {
+  private:
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    /**
+     * children are kept as a list: child is the first one, sibling the
+     * next; prev is the parent for a first child, else the left sibling.
+     */
+    struct Node {
+      Node* child, * sibling, * prev;
+      T val;
+      template<class... Args>
+      Node(Args&&... args) : child(nullptr), sibling(nullptr), prev(nullptr),
+        val(std::forward<Args>(args)...) {}
+    };
+  public:
+    /**
+     * refers to one element of the heap.
+     */
+    class handle {
+      friend class pairing_heap;
+    private:
+      Node* p;
+      handle(Node* x) : p(x) {}
+    public:
+      handle() : p(nullptr) {}
+      const T& operator*() const {
+        return p->val;
+      }
+      const T* operator->() const {
+        return &p->val;
+      }
+      bool operator==(const handle& rhs) const {
+        return p == rhs.p;
+      }
+      bool operator!=(const handle& rhs) const {
+        return p != rhs.p;
+      }
+    };
+  private:
+    Node* root;
+    size_t n;
+    node_pool<Node> pool;
+    template<class... Args>
+    Node* newNode(Args&&... args) {
+      Node* x = pool.allocate();
+      try {
+        new (x) Node(std::forward<Args>(args)...);
+      }
+      catch (...) {
+        pool.deallocate(x);
+        throw;
+      }
+      return x;
+    }
+    void freeNode(Node* x) {
+      x->~Node();
+      pool.deallocate(x);
+    }
+    /**
+     * make the loser of two roots the first child of the winner.
+     * the comparison happens before anything is touched.
+     */
+    Node* link(Node* a, Node* b) {
+      if (comp()(a->val, b->val)) std::swap(a, b);
+      hang(a, b);
+      return a;
+    }
+    /**
+     * put the root y in front of the children of x, no comparison.
+     */
+    static void hang(Node* x, Node* y) {
+      y->sibling = x->child;
+      if (x->child) x->child->prev = y;
+      y->prev = x;
+      x->child = y;
+    }
+    /**
+     * hang every tree of a sibling chain under x.
+     */
+    static void hangAll(Node* x, Node* list) {
+      while (list) {
+        Node* next = list->sibling;
+        hang(x, list);
+        list = next;
+      }
+    }
+    /**
+     * detach the subtree of a non-root node from its parent.
+     */
+    static void cut(Node* x) {
+      if (x->prev->child == x) x->prev->child = x->sibling;
+      else x->prev->sibling = x->sibling;
+      if (x->sibling) x->sibling->prev = x->prev;
+      x->sibling = x->prev = nullptr;
+    }
+    /**
+     * two-pass pairing of the children of x into a single tree, which is
+     * returned with x left childless.
+     * first pass: link neighbours left to right, collecting the winners
+     * in reverse order; second pass: fold them right to left.
+     * if Compare throws, all pieces go back under x.
+     */
+    Node* combine(Node* x) {
+      Node* rest = x->child, * pairs = nullptr, * acc = nullptr;
+      Node* a = nullptr, * b = nullptr;
+      try {
+        while (rest) {
+          a = rest; b = rest->sibling;
+          rest = b ? b->sibling : nullptr;
+          a->sibling = nullptr;
+          if (b) {
+            b->sibling = nullptr;
+            a = link(a, b);
+            b = nullptr;
+          }
+          a->sibling = pairs; pairs = a;
+          a = nullptr;
+        }
+        while (pairs) {
+          a = pairs; pairs = pairs->sibling;
+          a->sibling = nullptr;
+          acc = acc ? link(acc, a) : a;
+          a = nullptr;
+        }
+      }
+      catch (...) {
+        x->child = nullptr;
+        hangAll(x, rest);
+        hangAll(x, pairs);
+        if (acc) hang(x, acc);
+        if (a) hang(x, a);
+        if (b) hang(x, b);
+        throw;
+      }
+      x->child = nullptr;
+      if (acc) acc->prev = nullptr;
+      return acc;
+    }
+    Node* check(const handle& h) const {
+      if (!h.p) throw(invalid_iterator());
+      return h.p;
+    }
+    /**
+     * destroy a whole tree without recursion by rotating first children
+     * into the sibling chain.
+     */
+    void del(Node* x) {
+      while (x) {
+        if (x->child) {
+          Node* c = x->child;
+          x->child = c->sibling;
+          c->sibling = x;
+          x = c;
+        }
+        else {
+          Node* next = x->sibling;
+          freeNode(x);
+          x = next;
+        }
+      }
+    }
+    /**
+     * preorder walk of src that builds the same shape; climbing back up
+     * follows prev pointers, so no stack is needed.
+     */
+    Node* copy(const Node* src) {
+      if (!src) return nullptr;
+      Node* res = newNode(src->val);
+      try {
+        const Node* s = src;
+        Node* d = res;
+        for (;;) {
+          if (s->child) {
+            hang(d, newNode(s->child->val));
+            s = s->child; d = d->child;
+            continue;
+          }
+          while (s != src && !s->sibling) {
+            while (s->prev->child != s) s = s->prev, d = d->prev;
+            s = s->prev; d = d->prev;
+          }
+          if (s == src) break;
+          Node* c = newNode(s->sibling->val);
+          c->prev = d; d->sibling = c;
+          s = s->sibling; d = c;
+        }
+      }
+      catch (...) {
+        del(res);
+        throw;
+      }
+      return res;
+    }
+    /**
+     * link a fresh node into the heap, or free it again if Compare throws.
+     */
+    handle pushNode(Node* x) {
+      if (root) {
+        try {
+          root = link(root, x);
+        }
+        catch (...) {
+          freeNode(x);
+          throw;
+        }
+      }
+      else root = x;
+      ++n;
+      return handle(x);
+    }
+    /**
+     * give x the value e, which does not compare less than its old one.
+     */
+    void raise(Node* x, const T& e) {
+      if (x == root) {
+        x->val = e;
+        return;
+      }
+      bool above = comp()(root->val, e);
+      cut(x);
+      x->val = e;
+      if (above) {
+        hang(x, root);
+        root = x;
+      }
+      else hang(root, x);
+    }
+    /**
+     * give x the value e, which does not compare greater than its old one.
+     */
+    void lower(Node* x, const T& e) {
+      Node* c = combine(x);
+      if (x != root) {
+        cut(x);
+        x->val = e;
+        hang(root, x);
+        if (c) hang(root, c);
+        return;
+      }
+      if (!c) {
+        x->val = e;
+        return;
+      }
+      bool below;
+      try {
+        below = comp()(e, c->val);
+      }
+      catch (...) {
+        hang(x, c);
+        throw;
+      }
+      x->val = e;
+      if (below) {
+        hang(c, x);
+        root = c;
+      }
+      else hang(x, c);
+    }
+  public:
+    /**
+     * constructors
+     */
+    pairing_heap() : Holder(Compare()), root(nullptr), n(0) {}
+    explicit pairing_heap(const Compare& c) : Holder(c), root(nullptr), n(0) {}
+    pairing_heap(const pairing_heap& other) : Holder(other), root(nullptr), n(0) {
+      root = copy(other.root);
+      n = other.n;
+    }
+    /**
+     * deconstructor
+     */
+    ~pairing_heap() {
+      clear();
+    }
+    /**
+     * Assignment operator
+     */
+    pairing_heap& operator=(const pairing_heap& other) {
+      if (&other == this) return (*this);
+      clear();
+      Holder::operator=(other);
+      root = copy(other.root);
+      n = other.n;
+      return (*this);
+    }
+    /**
+     * the comparator the heap orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * get the top of the queue.
+     * @return a reference of the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top() const {
+      if (!root) throw(container_is_empty());
+      return root->val;
+    }
+    /**
+     * push new element to the priority queue in O(1).
+     * @return a handle to the new element.
+     */
+    handle push(const T& e) {
+      return pushNode(newNode(e));
+    }
+    handle push(T&& e) {
+      return pushNode(newNode(std::move(e)));
+    }
+    /**
+     * construct the new element in place from args.
+     */
+    template<class... Args>
+    handle emplace(Args&&... args) {
+      return pushNode(newNode(std::forward<Args>(args)...));
+    }
+    /**
+     * delete the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (!root) throw(container_is_empty());
+      Node* acc = combine(root);
+      freeNode(root);
+      root = acc;
+      --n;
+    }
+    /**
+     * delete the top element and hand it out, moved rather than copied.
+     * throw container_is_empty if empty() returns true;
+     */
+    T pop_value() {
+      if (!root) throw(container_is_empty());
+      Node* acc = combine(root);
+      Node* tmp = root;
+      root = acc;
+      --n;
+      T res(std::move(tmp->val));
+      freeNode(tmp);
+      return res;
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !root;
+    }
+    void clear() {
+      if (!std::is_trivially_destructible<T>::value) del(root);
+      root = nullptr; n = 0;
+      pool.clear();
+    }
+    /**
+     * merge two pairing heaps in O(1).
+     * clear the other pairing heap.
+     */
+    void merge(pairing_heap& other) {
+      if (&other == this || !other.root) return;
+      root = root ? link(root, other.root) : other.root;
+      n += other.n;
+      other.root = nullptr; other.n = 0;
+      pool.adopt(other.pool);
+    }
+    /**
+     * replace the element of h by e, which should not compare less than
+     * the old one (it moves towards the top). O(1).
+     * one comparison with the old element checks the direction; if e is
+     * less after all, it is handled as by decrease_key.
+     */
+    void increase_key(const handle& h, const T& e) {
+      Node* x = check(h);
+      if (comp()(e, x->val)) lower(x, e);
+      else raise(x, e);
+    }
+    /**
+     * replace the element of h by e, which should not compare greater than
+     * the old one (it moves away from the top). amortized O(log n):
+     * the children of the element are paired up and hung back.
+     * one comparison with the old element checks the direction; if e is
+     * greater after all, it is handled as by increase_key.
+     */
+    void decrease_key(const handle& h, const T& e) {
+      Node* x = check(h);
+      if (comp()(x->val, e)) raise(x, e);
+      else lower(x, e);
+    }
+    /**
+     * replace the element of h by e, whichever way it moves.
+     */
+    void modify(const handle& h, const T& e) {
+      increase_key(h, e);
+    }
+    /**
+     * remove the element of h, amortized O(log n).
+     */
+    void erase(const handle& h) {
+      Node* x = check(h);
+      if (x == root) {
+        pop();
+        return;
+      }
+      Node* c = combine(x);
+      cut(x);
+      if (c) hang(root, c);
+      freeNode(x);
+      --n;
+    }
+  };
+
+}
+
+#endif
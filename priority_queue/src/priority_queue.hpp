@@ -1,82 +1,819 @@
 #ifndef SJTU_PRIORITY_QUEUE_HPP
 #define SJTU_PRIORITY_QUEUE_HPP
 
+// only the headers of the framework: std::swap, std::move, placement new
+// and the type traits come with <functional>, as std::swap always has
 #include <cstddef>
+#include <cstring>
 #include <functional>
 #include "exceptions.hpp"
 
 namespace sjtu {
 
   /**
-   * a container like std::priority_queue which is a heap internal.
+   * the comparator of a queue, stored once per queue. every heap here
+   * keeps its Compare in one, copies it along with the heap, and merges
+   * by the one of the heap merged into. an empty Compare such as
+   * std::less is a base here, so it takes no room.
+   */
+  template<class Compare, bool Empty = std::is_empty<Compare>::value && !std::is_final<Compare>::value>
+  class CompareHolder : private Compare {
+  public:
+    explicit CompareHolder(const Compare& c) : Compare(c) {}
+    const Compare& comp() const {
+      return *this;
+    }
+  };
+  template<class Compare>
+  class CompareHolder<Compare, false> {
+  private:
+    Compare c;
+  public:
+    explicit CompareHolder(const Compare& _c) : c(_c) {}
+    const Compare& comp() const {
+      return c;
+    }
+  };
+
+  /**
+   * a slab allocator handing out raw storage for one kind of node.
+   * allocate/deallocate are O(1) and never touch the global allocator
+   * except to grab a new slab; slabs are only given back as a whole,
+   * by clear() or the destructor.
+   * the pool never constructs or destroys nodes, that is up to the owner.
+   */
+  template<class Node>
+  class node_pool {
+  private:
+    union Slot {
+      Slot* next;
+      alignas(Node) unsigned char buf[sizeof(Node)];
+    };
+    struct Slab {
+      Slab* next;
+      Slot* slots;
+    };
+    enum : size_t {
+      minSlab = 16,
+      maxSlab = sizeof(Node) * 4096 > 65536 ? 4096 : 65536 / sizeof(Node)
+    };
+    Slab* slabs, * lastSlab;
+    Slot* cur, * end;
+    Slot* freeHead, * freeTail;
+    size_t nextCap, cap;
+    void grow(size_t count) {
+      Slab* s = new Slab;
+      try {
+        s->slots = new Slot[count];
+      }
+      catch (...) {
+        delete s;
+        throw;
+      }
+      s->next = slabs; slabs = s;
+      if (!lastSlab) lastSlab = s;
+      cur = s->slots; end = cur + count;
+      cap += count;
+    }
+  public:
+    node_pool() : slabs(nullptr), lastSlab(nullptr), cur(nullptr), end(nullptr),
+      freeHead(nullptr), freeTail(nullptr), nextCap(minSlab), cap(0) {}
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+    ~node_pool() {
+      clear();
+    }
+    /**
+     * storage for one node, not constructed.
+     */
+    Node* allocate() {
+      if (freeHead) {
+        Slot* s = freeHead;
+        freeHead = s->next;
+        if (!freeHead) freeTail = nullptr;
+        return reinterpret_cast<Node*>(s);
+      }
+      if (cur == end) {
+        grow(nextCap);
+        if (nextCap < maxSlab) nextCap = nextCap * 2 > maxSlab ? maxSlab : nextCap * 2;
+      }
+      return reinterpret_cast<Node*>(cur++);
+    }
+    /**
+     * make sure the next cnt allocations come from one slab, grabbed in a
+     * single allocation if the current one is too small; for bulk loads.
+     */
+    void reserve(size_t cnt) {
+      if ((size_t)(end - cur) < cnt) grow(cnt);
+    }
+    /**
+     * give back storage of a node which has already been destroyed.
+     */
+    void deallocate(Node* x) {
+      Slot* s = reinterpret_cast<Slot*>(x);
+      s->next = freeHead;
+      if (!freeHead) freeTail = s;
+      freeHead = s;
+    }
+    /**
+     * release every slab at once.
+     * all nodes handed out must have been destroyed before.
+     */
+    void clear() {
+      while (slabs) {
+        Slab* s = slabs;
+        slabs = s->next;
+        delete[] s->slots;
+        delete s;
+      }
+      lastSlab = nullptr;
+      cur = end = nullptr;
+      freeHead = freeTail = nullptr;
+      nextCap = minSlab; cap = 0;
+    }
+    /**
+     * take over all slabs of other in O(1), so that nodes allocated from
+     * other stay valid after their heap is merged into ours.
+     * the unused tail of the smaller bump region is simply dropped
+     * until the slabs are released.
+     */
+    void adopt(node_pool& other) {
+      if (&other == this || !other.slabs) return;
+      other.lastSlab->next = slabs;
+      if (!slabs) lastSlab = other.lastSlab;
+      slabs = other.slabs;
+      if (other.end - other.cur > end - cur) {
+        cur = other.cur; end = other.end;
+      }
+      if (other.freeHead) {
+        if (freeHead) other.freeTail->next = freeHead;
+        else freeTail = other.freeTail;
+        freeHead = other.freeHead;
+      }
+      cap += other.cap;
+      if (other.nextCap > nextCap) nextCap = other.nextCap;
+      other.slabs = other.lastSlab = nullptr;
+      other.cur = other.end = nullptr;
+      other.freeHead = other.freeTail = nullptr;
+      other.nextCap = minSlab; other.cap = 0;
+    }
+    /**
+     * the number of nodes the slabs can hold.
+     */
+    size_t capacity() const {
+      return cap;
+    }
+  };
+
+  /**
+   * contiguous growable storage for the array-backed heaps.
+   * only what the heaps need: no iterators, no bound checks.
    */
   template<class T>
-  class Node {
+  class heap_array {
+  private:
+    T* a;
+    size_t len, cap;
+    static T* allocate(size_t n) {
+      if (n > (size_t)-1 / sizeof(T)) throw(std::bad_alloc());
+      return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+    void destroy() {
+      for (size_t i = 0; i < len; ++i) a[i].~T();
+      len = 0;
+    }
+    void regrow(size_t newCap) {
+      T* b = allocate(newCap);
+      size_t i = 0;
+      try {
+        for (; i < len; ++i) new (b + i) T(std::move_if_noexcept(a[i]));
+      }
+      catch (...) {
+        while (i) b[--i].~T();
+        ::operator delete(b);
+        throw;
+      }
+      destroy();
+      ::operator delete(a);
+      a = b; len = i; cap = newCap;
+    }
   public:
-    Node<T>* lc, * rc;
-    int dis, siz;
+    heap_array() : a(nullptr), len(0), cap(0) {}
+    heap_array(const heap_array& other) : a(nullptr), len(0), cap(0) {
+      reserve(other.len);
+      for (; len < other.len; ++len) new (a + len) T(other.a[len]);
+    }
+    heap_array(heap_array&& other) : a(other.a), len(other.len), cap(other.cap) {
+      other.a = nullptr;
+      other.len = other.cap = 0;
+    }
+    heap_array& operator=(const heap_array& other) {
+      if (&other == this) return (*this);
+      heap_array tmp(other);
+      swap(tmp);
+      return (*this);
+    }
+    heap_array& operator=(heap_array&& other) {
+      if (&other == this) return (*this);
+      destroy();
+      ::operator delete(a);
+      a = other.a; len = other.len; cap = other.cap;
+      other.a = nullptr;
+      other.len = other.cap = 0;
+      return (*this);
+    }
+    ~heap_array() {
+      destroy();
+      ::operator delete(a);
+    }
+    void swap(heap_array& other) {
+      std::swap(a, other.a);
+      std::swap(len, other.len);
+      std::swap(cap, other.cap);
+    }
+    /**
+     * make room for at least n elements, growing geometrically,
+     * so that references taken afterwards survive the next push_back.
+     */
+    void reserve(size_t n) {
+      if (n <= cap) return;
+      size_t newCap = cap * 2 > n ? cap * 2 : n;
+      regrow(newCap < 8 ? 8 : newCap);
+    }
+    /**
+     * make room for exactly n elements, for a size known in advance.
+     */
+    void reserve_exact(size_t n) {
+      if (n > cap) regrow(n);
+    }
+    /**
+     * args must not point into the array unless room was reserved first.
+     */
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+      reserve(len + 1);
+      new (a + len) T(std::forward<Args>(args)...);
+      ++len;
+    }
+    void push_back(const T& e) {
+      emplace_back(e);
+    }
+    void push_back(T&& e) {
+      emplace_back(std::move(e));
+    }
+    void pop_back() {
+      a[--len].~T();
+    }
+    void clear() {
+      destroy();
+    }
+    /**
+     * give the memory back as well.
+     */
+    void release() {
+      destroy();
+      ::operator delete(a);
+      a = nullptr; cap = 0;
+    }
+    T& operator[](size_t i) {
+      return a[i];
+    }
+    const T& operator[](size_t i) const {
+      return a[i];
+    }
+    T& back() {
+      return a[len - 1];
+    }
+    T* data() {
+      return a;
+    }
+    const T* data() const {
+      return a;
+    }
+    size_t size() const {
+      return len;
+    }
+    size_t capacity() const {
+      return cap;
+    }
+    bool empty() const {
+      return !len;
+    }
+    /**
+     * whether p points at an element of the array, which a push may
+     * move or reallocate under it.
+     */
+    bool owns(const T* p) const {
+      std::less<const T*> before;
+      return len && !before(p, a) && before(p, a + len);
+    }
+  };
+
+  /**
+   * what a priority_queue in stats mode has counted since it was built
+   * or last reset.
+   * pop cost is the number of comparisons one pop made; popCost[0]
+   * counts pops that made none, popCost[b] those that made 2^(b-1) up
+   * to 2^b - 1, and the last bucket everything above.
+   * comparisons are added up when a merge or sort is done, so those of
+   * one cut short by a throwing Compare are not counted.
+   */
+  struct heap_stats {
+    static const int popBuckets = 16;
+    unsigned long long comparisons;
+    unsigned long long merges, mergePath, longestPath;  // merge path lengths
+    unsigned long long allocations, slabs;  // nodes, and slabs grabbed for them
+    unsigned long long pops;
+    unsigned int maxRank;  // the highest rank any merge has given a node
+    unsigned long long popCost[popBuckets];
+    heap_stats() {
+      reset();
+    }
+    void reset() {
+      comparisons = merges = mergePath = longestPath = 0;
+      allocations = slabs = pops = 0;
+      maxRank = 0;
+      for (int b = 0; b < popBuckets; ++b) popCost[b] = 0;
+    }
+    static int bucket(unsigned long long cost) {
+      int b = 0;
+      while (cost && b < popBuckets - 1) cost >>= 1, ++b;
+      return b;
+    }
+    /**
+     * write the counters to os as text, one per line; Stream is e.g.
+     * std::ostream.
+     */
+    template<class Stream>
+    void dump(Stream& os) const {
+      os << "comparisons " << comparisons << '\n';
+      os << "merges " << merges << '\n';
+      os << "merge path total " << mergePath << " longest " << longestPath << '\n';
+      os << "allocations " << allocations << " slabs " << slabs << '\n';
+      os << "max rank " << maxRank << '\n';
+      os << "pops " << pops << '\n';
+      for (int b = 0; b < popBuckets; ++b) {
+        if (!popCost[b]) continue;
+        unsigned long long lo = b ? 1ull << (b - 1) : 0;
+        os << "pop cost " << lo;
+        if (b == popBuckets - 1) os << "+";
+        else if (b > 1) os << "-" << (1ull << b) - 1;
+        os << ": " << popCost[b] << '\n';
+      }
+    }
+  };
+
+  /**
+   * the hooks a priority_queue calls as it works; without stats mode
+   * they are empty and take no room, so they compile out.
+   */
+  template<bool Enabled>
+  class StatsRecorder {
+  public:
+    void countCompares(unsigned long long) const {}
+    void countMerge(int, unsigned long long) const {}
+    void countRank(unsigned int) const {}
+    void countAlloc(size_t, size_t) const {}
+    unsigned long long popStart() const {
+      return 0;
+    }
+    void countPop(unsigned long long) const {}
+  };
+  template<>
+  class StatsRecorder<true> {
+  public:
+    // counted from const members too, e.g. to_sorted_vector
+    mutable heap_stats rec;
+    void countCompares(unsigned long long k) const {
+      rec.comparisons += k;
+    }
+    /**
+     * one merge along a path of len nodes, which took cmp comparisons.
+     */
+    void countMerge(int len, unsigned long long cmp) const {
+      rec.comparisons += cmp;
+      ++rec.merges;
+      rec.mergePath += len;
+      if ((unsigned long long)len > rec.longestPath) rec.longestPath = len;
+    }
+    void countRank(unsigned int r) const {
+      if (r > rec.maxRank) rec.maxRank = r;
+    }
+    /**
+     * one node allocated; the pool held capBefore nodes before, capAfter
+     * after.
+     */
+    void countAlloc(size_t capBefore, size_t capAfter) const {
+      ++rec.allocations;
+      if (capAfter != capBefore) ++rec.slabs;
+    }
+    unsigned long long popStart() const {
+      return rec.comparisons;
+    }
+    void countPop(unsigned long long start) const {
+      ++rec.pops;
+      ++rec.popCost[heap_stats::bucket(rec.comparisons - start)];
+    }
+  };
+
+  /**
+   * the binary snapshots of the heaps: a header, then fixed-size records.
+   * everything is raw bytes in the byte order of the machine, so a
+   * snapshot is only meant to be loaded where it was saved.
+   * Stream is anything with write(const char*, n) or read(char*, n) that
+   * converts to false on failure, e.g. std::ofstream / std::ifstream.
+   */
+  struct snapshot_header {
+    char magic[4];
+    unsigned int kind;  // which container wrote it
+    unsigned long long elemSize, count, stamps;
+  };
+
+  /**
+   * buffers of at least 64 KiB, and never smaller than a record.
+   */
+  inline size_t snapshotBuffer(size_t recordSize) {
+    return recordSize > 65536 ? recordSize : 65536;
+  }
+
+  /**
+   * how many records a load should make room for up front: the count of
+   * the header, but no more than 64 MiB worth, so that a damaged header
+   * cannot grab more memory than the stream holds; past that, storage
+   * grows as the records arrive.
+   */
+  inline size_t snapshotReserve(unsigned long long count, size_t recordSize) {
+    size_t most = (64u << 20) / recordSize;
+    return count < most ? (size_t)count : most;
+  }
+
+  template<class Stream>
+  class snapshot_writer {
+  private:
+    Stream& os;
+    size_t cap;
+    char* buf;
+    size_t len;
+  public:
+    /**
+     * write the header; the records will be recordSize bytes.
+     */
+    snapshot_writer(Stream& s, unsigned int kind, size_t elemSize, size_t recordSize,
+      size_t count, unsigned long long stamps) :
+      os(s), cap(snapshotBuffer(recordSize)), buf(new char[cap]), len(0) {
+      snapshot_header h;
+      std::memset(&h, 0, sizeof(h));
+      std::memcpy(h.magic, "SJPQ", 4);
+      h.kind = kind;
+      h.elemSize = elemSize; h.count = count; h.stamps = stamps;
+      put(&h, sizeof(h));
+    }
+    snapshot_writer(const snapshot_writer&) = delete;
+    snapshot_writer& operator=(const snapshot_writer&) = delete;
+    ~snapshot_writer() {
+      delete[] buf;
+    }
+    void put(const void* p, size_t n) {
+      if (len + n > cap) flush();
+      std::memcpy(buf + len, p, n);
+      len += n;
+    }
+    /**
+     * throw runtime_error if the stream fails.
+     */
+    void flush() {
+      if (len && !os.write(buf, len)) throw(runtime_error());
+      len = 0;
+    }
+  };
+
+  template<class Stream>
+  class snapshot_reader {
+  private:
+    Stream& is;
+    size_t cap;
+    char* buf;
+    size_t pos, len;
+    unsigned long long left;  // bytes of records not read from is yet
+  public:
+    snapshot_header header;
+    /**
+     * read and check the header; the records must be recordSize bytes.
+     * throw runtime_error if it does not match.
+     */
+    snapshot_reader(Stream& s, unsigned int kind, size_t elemSize, size_t recordSize) :
+      is(s), cap(snapshotBuffer(recordSize)), buf(nullptr), pos(0), len(0), left(0) {
+      if (!is.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, "SJPQ", 4) || header.kind != kind
+        || header.elemSize != elemSize
+        || header.count > (unsigned long long)-1 / recordSize) throw(runtime_error());
+      left = header.count * recordSize;
+      buf = new char[cap];
+    }
+    snapshot_reader(const snapshot_reader&) = delete;
+    snapshot_reader& operator=(const snapshot_reader&) = delete;
+    ~snapshot_reader() {
+      delete[] buf;
+    }
+    /**
+     * the next n bytes, n no more than a record.
+     * throw runtime_error if the stream ends early.
+     */
+    const char* get(size_t n) {
+      if (pos + n > len) {
+        size_t keep = len - pos;
+        std::memmove(buf, buf + pos, keep);
+        size_t want = cap - keep;
+        if (want > left) want = left;
+        if (keep + want < n || !is.read(buf + keep, want)) throw(runtime_error());
+        left -= want;
+        pos = 0; len = keep + want;
+      }
+      const char* p = buf + pos;
+      pos += n;
+      return p;
+    }
+  };
+
+
+  /**
+   * the insertion stamp of a node, kept only in stable mode.
+   */
+  template<bool Stable>
+  class NodeStamp {
+  public:
+    void stamp(unsigned long long) {}
+    unsigned long long stamped() const {
+      return 0;
+    }
+    bool later(const NodeStamp&) const {
+      return false;
+    }
+  };
+  template<>
+  class NodeStamp<true> {
+  public:
+    unsigned long long seq;
+    void stamp(unsigned long long s) {
+      seq = s;
+    }
+    unsigned long long stamped() const {
+      return seq;
+    }
+    bool later(const NodeStamp& other) const {
+      return seq > other.seq;
+    }
+  };
+  /**
+   * the next insertion stamp of a queue, kept only in stable mode.
+   */
+  template<bool Stable>
+  class StampCounter {
+  public:
+    unsigned long long nextStamp() {
+      return 0;
+    }
+    unsigned long long stampCount() const {
+      return 0;
+    }
+    void setStamps(unsigned long long) {}
+    void joinStamps(const StampCounter&) {}
+  };
+  template<>
+  class StampCounter<true> {
+  public:
+    unsigned long long stamps;
+    StampCounter() :stamps(0) {}
+    unsigned long long nextStamp() {
+      return stamps++;
+    }
+    unsigned long long stampCount() const {
+      return stamps;
+    }
+    void setStamps(unsigned long long s) {
+      stamps = s;
+    }
+    /**
+     * after a merge the counter continues past both queues.
+     */
+    void joinStamps(const StampCounter& other) {
+      if (other.stamps > stamps) stamps = other.stamps;
+    }
+  };
+  /**
+   * a container like std::priority_queue which is a heap internal.
+   */
+  template<class T, bool Stable = false>
+  class Node : public NodeStamp<Stable> {
+  public:
+    Node* lc, * rc;
+    // the rank of a leftist heap is below log2(n + 1), so a byte is plenty
+    unsigned char dis;
     T val;
-    Node<T>() : lc(nullptr), rc(nullptr), dis(0), siz(0) {}
-    Node<T>(const Node* other) : lc(nullptr), rc(nullptr),
-      dis(other->dis), val(other->val), siz(other->siz) {}
-    Node<T>(const T& e) : lc(nullptr), rc(nullptr), siz(1), dis(0), val(e) {}
+    Node() : lc(nullptr), rc(nullptr), dis(0) {}
+    Node(const Node* other) : NodeStamp<Stable>(*other), lc(nullptr), rc(nullptr),
+      dis(other->dis), val(other->val) {}
+    template<class... Args>
+    Node(Args&&... args) : lc(nullptr), rc(nullptr), dis(0),
+      val(std::forward<Args>(args)...) {}
   };
-  template<typename T, class Compare = std::less<T>>
-  class priority_queue {
+  /**
+   * a leftist heap. every merge makes all its comparisons before it
+   * rewires a single node (see mergeNode), so if Compare throws in push,
+   * pop, push_range or merge, both heaps are exactly as they were; the
+   * O(log n) merge path itself is all that needs remembering, there is
+   * nothing to undo and nothing to copy.
+   * with Stable set, elements that compare equal come out in the order
+   * they were pushed: every node is stamped with a 64-bit insertion
+   * counter, which is looked at only when Compare finds neither element
+   * smaller.
+   * the queue keeps its own copy of Compare, given to the constructor,
+   * so a comparator may carry state.
+   * with Stats set, the queue counts its comparisons, merge paths,
+   * allocations and the cost of every pop, see heap_stats and
+   * stats(); without it, the counting compiles out and takes no room.
+   */
+  template<typename T, class Compare = std::less<T>, bool Stable = false, bool Stats = false>
+  class priority_queue : public CompareHolder<Compare>, public StatsRecorder<Stats>, public StampCounter<Stable> {
   public:
+    typedef CompareHolder<Compare> Holder;
+    typedef StatsRecorder<Stats> Recorder;
+    typedef StampCounter<Stable> Stamps;
+    using Holder::comp;
     /**
      * constructors
      */
-    Node<T>* root;
-    void update(Node<T>* x) {
-      x->siz = 1;
-      if (x->lc) x->siz += x->lc->siz;
-      if (x->rc) x->siz += x->rc->siz;
-    }
-    Node<T>* mergeNode(Node<T>* x, Node<T>* y) {
-      if (!x) return y;
-      if (!y) return x;
-      if (Compare()(x->val, y->val)) std::swap(x, y);
-      x->rc = mergeNode(x->rc, y);
-      if (!x->lc) {
-        x->dis = 0; std::swap(x->rc, x->lc);
-        update(x);
-        return x;
-      }
-      if (x->rc->dis > x->lc->dis) std::swap(x->rc, x->lc);
-      x->dis = x->rc->dis + 1; update(x);
+    typedef sjtu::Node<T, Stable> Node;
+    Node* root;
+    size_t n;
+    node_pool<Node> pool;
+    /**
+     * nodes live in the pool of the queue, never in the global heap.
+     */
+    template<class... Args>
+    Node* newNode(Args&&... args) {
+      size_t cap = pool.capacity();
+      Node* x = pool.allocate();
+      this->countAlloc(cap, pool.capacity());
+      try {
+        new (x) Node(std::forward<Args>(args)...);
+      }
+      catch (...) {
+        pool.deallocate(x);
+        throw;
+      }
       return x;
     }
-    priority_queue() :root(nullptr) {}
-    void copy(Node<T>*& x, const Node<T>* other) {
+    void freeNode(Node* x) {
+      x->~Node();
+      pool.deallocate(x);
+    }
+    /**
+     * whether x belongs below y; in stable mode the later push loses a tie.
+     * cmp counts the calls to Compare, in a local of the caller so that
+     * stats mode does not store to memory on every comparison.
+     */
+    template<class X>
+    bool below(const X* x, const X* y, unsigned long long& cmp) const {
+      ++cmp;
+      if (comp()(x->val, y->val)) return true;
+      if (!Stable) return false;
+      ++cmp;
+      return !comp()(y->val, x->val) && x->later(*y);
+    }
+    /**
+     * right spines of a leftist heap are at most log2(n + 1) long.
+     */
+    static const int maxPath = 128;
+    /**
+     * merge along the right spines without recursion. the first pass only
+     * compares, recording the merge path; the second links it up from the
+     * bottom and fixes the ranks, so a throwing Compare changes nothing.
+     */
+    Node* mergeNode(Node* x, Node* y) {
+      Node* path[maxPath];
+      int len = 0;
+      unsigned long long cmp = 0;
+      while (x && y) {
+        if (below(x, y, cmp)) std::swap(x, y);
+        path[len++] = x;
+        x = x->rc;
+      }
+      this->countMerge(len, cmp);
+      return link(path, len, x ? x : y);
+    }
+    /**
+     * the second pass of a merge: hang cur below the last of the len path
+     * nodes, that one below the one before, and so on, fixing the ranks.
+     * @return the first path node, or cur if the path is empty.
+     */
+    Node* link(Node* const* path, int len, Node* cur) const {
+      while (len--) {
+        Node* x = path[len];
+        x->rc = cur;
+        if (!x->lc) {
+          x->dis = 0; std::swap(x->rc, x->lc);
+        }
+        else {
+          if (x->rc->dis > x->lc->dis) std::swap(x->rc, x->lc);
+          x->dis = x->rc->dis + 1;
+        }
+        this->countRank(x->dis);
+        cur = x;
+      }
+      return cur;
+    }
+    /**
+     * a heap of the elements of [first, last) in O(n): singletons are
+     * merged pairwise, round after round, as if taken from a FIFO queue.
+     * if anything throws, the new nodes are freed again.
+     * @param added set to the number of elements.
+     */
+    template<class InputIterator>
+    Node* build(InputIterator first, InputIterator last, size_t& added) {
+      heap_array<Node*> a;
+      size_t cnt = 0, i = 0;
+      try {
+        for (; first != last; ++first) {
+          a.reserve(a.size() + 1);
+          a.push_back(newNode(*first));
+          a.back()->stamp(this->nextStamp());
+        }
+        for (cnt = a.size(); cnt > 1; cnt = i) {
+          for (i = 0; 2 * i + 1 < cnt; ++i) a[i] = mergeNode(a[2 * i], a[2 * i + 1]);
+          if (cnt & 1) a[i++] = a[cnt - 1];
+        }
+      }
+      catch (...) {
+        // mid-round the heaps are a[0, i), already merged, and a[2i, cnt)
+        if (!cnt) cnt = a.size();
+        else {
+          for (size_t k = 0; k < i; ++k) del(a[k]);
+          i *= 2;
+        }
+        for (; i < cnt; ++i) del(a[i]);
+        throw;
+      }
+      added = a.size();
+      return a.empty() ? nullptr : a[0];
+    }
+    priority_queue() :Holder(Compare()), root(nullptr), n(0) {}
+    explicit priority_queue(const Compare& c) :Holder(c), root(nullptr), n(0) {}
+    /**
+     * build from a range in O(n).
+     */
+    template<class InputIterator>
+    priority_queue(InputIterator first, InputIterator last, const Compare& c = Compare()) :
+      Holder(c), root(nullptr), n(0) {
+      root = build(first, last, n);
+    }
+    void copy(Node*& x, const Node* other) {
       if (!other) return;
-      x = new Node<T>(other);
+      x = newNode(other);
       copy(x->lc, other->lc); copy(x->rc, other->rc);
     }
-    priority_queue(const priority_queue& other) {
+    priority_queue(const priority_queue& other) :Holder(other), Recorder(), Stamps(other), root(nullptr), n(0) {
       copy(root, other.root);
+      n = other.n;
     }
     /**
      * deconstructor
      */
-    void del(Node<T>* x) {
+    void del(Node* x) {
       if (!x) return;
       del(x->lc); del(x->rc);
-      delete x;
+      freeNode(x);
     }
-    ~priority_queue() {
-      del(root);
+    /**
+     * destroy every element and hand all slabs back at once.
+     */
+    void clear() {
+      if (!std::is_trivially_destructible<T>::value) del(root);
       root = nullptr;
+      n = 0;
+      pool.clear();
+    }
+    ~priority_queue() {
+      clear();
     }
     /**
      * Assignment operator
      */
     priority_queue& operator=(const priority_queue& other) {
       if (&other == this) return (*this);
-      del(root);
+      clear();
+      Holder::operator=(other);
       copy(root, other.root);
+      n = other.n;
+      Stamps::operator=(other);
       return (*this);
     }
+    /**
+     * the comparator the queue orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
     /**
      * get the top of the queue.
      * @return a reference of the top element.
@@ -86,18 +823,52 @@ namespace sjtu {
       if (!root) throw(container_is_empty());
       return root->val;
     }
+    /**
+     * link a fresh node into the heap, or free it again if Compare throws.
+     */
+    void pushNode(Node* x) {
+      x->stamp(this->nextStamp());
+      try {
+        root = mergeNode(root, x);
+      }
+      catch (...) {
+        freeNode(x);
+        throw;
+      }
+      ++n;
+    }
     /**
      * push new element to the priority queue.
      */
     void push(const T& e) {
-      Node<T>* x = new Node<T>(e);
+      pushNode(newNode(e));
+    }
+    void push(T&& e) {
+      pushNode(newNode(std::move(e)));
+    }
+    /**
+     * construct the new element in place from args.
+     */
+    template<class... Args>
+    void emplace(Args&&... args) {
+      pushNode(newNode(std::forward<Args>(args)...));
+    }
+    /**
+     * push all elements of [first, last), O(n + log size()).
+     * if Compare throws, none of them is pushed.
+     */
+    template<class InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+      size_t added;
+      Node* x = build(first, last, added);
       try {
         root = mergeNode(root, x);
       }
-      catch (runtime_error) {
-        delete x;
-        throw (runtime_error());
+      catch (...) {
+        del(x);
+        throw;
       }
+      n += added;
     }
     /**
      * delete the top element.
@@ -105,15 +876,55 @@ namespace sjtu {
      */
     void pop() {
       if (!root) throw(container_is_empty());
-      Node<T>* tmp = root;
+      unsigned long long start = this->popStart();
+      Node* tmp = root;
       root = mergeNode(root->lc, root->rc);
-      delete tmp;
+      this->countPop(start);
+      --n;
+      freeNode(tmp);
+    }
+    /**
+     * delete the top element and hand it out, moved rather than copied.
+     * throw container_is_empty if empty() returns true;
+     */
+    T pop_value() {
+      if (!root) throw(container_is_empty());
+      unsigned long long start = this->popStart();
+      Node* tmp = root;
+      root = mergeNode(root->lc, root->rc);
+      this->countPop(start);
+      --n;
+      T res(std::move(tmp->val));
+      freeNode(tmp);
+      return res;
     }
     /**
      * return the number of the elements.
      */
     size_t size() const {
-      return root->siz;
+      return n;
+    }
+    /**
+     * the counters of stats mode; a copy starts counting afresh.
+     */
+    const heap_stats& stats() const {
+      static_assert(Stats, "stats() needs stats mode");
+      return this->rec;
+    }
+    void reset_stats() {
+      static_assert(Stats, "reset_stats() needs stats mode");
+      this->rec.reset();
+    }
+    /**
+     * write the counters to os, then the shape of the heap now: its
+     * size, the rank of the root and the nodes the pool has room for.
+     */
+    template<class Stream>
+    void dump_stats(Stream& os) const {
+      stats().dump(os);
+      os << "size " << n << '\n';
+      os << "root rank " << (root ? (unsigned int)root->dis : 0u) << '\n';
+      os << "pool capacity " << pool.capacity() << '\n';
     }
     /**
      * check if the container has at least an element.
@@ -122,13 +933,571 @@ namespace sjtu {
     bool empty() const {
       return !root;
     }
+    /**
+     * Morris preorder walk from cur: a node with a left child is visited
+     * on the way down, after the right end of its left subtree has been
+     * threaded back to it; the thread is cut again on the way up.
+     * cur is moved on before f is called, so if f throws, the walk can
+     * go on from cur without it and undo the threads.
+     * f(x) sees x->rc possibly threaded; a node has a real right child
+     * iff its rank is not 0.
+     */
+    template<class F>
+    static void walk(Node*& cur, F& f) {
+      while (cur) {
+        Node* x = cur;
+        if (!x->lc) {
+          cur = x->rc;
+          f(static_cast<const Node*>(x));
+          continue;
+        }
+        Node* pre = x->lc;
+        while (pre->rc && pre->rc != x) pre = pre->rc;
+        if (pre->rc) {
+          pre->rc = nullptr;
+          cur = x->rc;
+        }
+        else {
+          pre->rc = x;
+          cur = x->lc;
+          f(static_cast<const Node*>(x));
+        }
+      }
+    }
+    struct Skip {
+      void operator()(const Node*) const {}
+    };
+    template<class F>
+    struct Visit {
+      F& f;
+      void operator()(const Node* x) const {
+        f(x->val);
+      }
+    };
+    /**
+     * walk the whole heap in preorder, undoing the threads if f throws.
+     */
+    template<class F>
+    void preorder(F f) const {
+      Node* cur = root;
+      try {
+        walk(cur, f);
+      }
+      catch (...) {
+        Skip skip;
+        walk(cur, skip);
+        throw;
+      }
+    }
+    /**
+     * call f(const T&) on every element, in no particular order, O(n)
+     * and without allocating or recursing.
+     * the walk threads right pointers through the heap and restores them
+     * before it returns, also when f throws; so f must not touch the
+     * queue, and no other thread may read it meanwhile.
+     */
+    template<class F>
+    void for_each(F f) const {
+      preorder(Visit<F>{ f });
+    }
+    /**
+     * a snapshot record is the stamp in stable mode, the element, and a
+     * byte with the rank and whether there is a left child; the right
+     * child exists iff the rank is not 0.
+     */
+    static const unsigned int snapshotKind = Stable ? 2 : 1;
+    static const size_t stampBytes = Stable ? sizeof(unsigned long long) : 0;
+    static const size_t recordBytes = stampBytes + sizeof(T) + 1;
+    template<class Stream>
+    struct Saver {
+      snapshot_writer<Stream>& w;
+      void operator()(const Node* x) const {
+        if (Stable) {
+          unsigned long long s = x->stamped();
+          w.put(&s, stampBytes);
+        }
+        w.put(&x->val, sizeof(T));
+        unsigned char b = x->dis | (x->lc ? 0x80 : 0);
+        w.put(&b, 1);
+      }
+    };
+    /**
+     * write the heap to os in preorder, shape and all, see snapshot_header.
+     * throw runtime_error if os fails.
+     */
+    template<class Stream>
+    void save(Stream& os) const {
+      static_assert(std::is_trivially_copyable<T>::value, "snapshots hold raw bytes");
+      snapshot_writer<Stream> w(os, snapshotKind, sizeof(T), recordBytes, n, this->stampCount());
+      preorder(Saver<Stream>{ w });
+      w.flush();
+    }
+    /**
+     * replace the contents by a snapshot taken with save(), in O(n)
+     * without a single comparison: the tree is rebuilt node by node in
+     * preorder, from one slab unless the snapshot is big. nodes still
+     * waiting for their right child are chained through their rc, so
+     * nothing else is allocated.
+     * the order of the elements is trusted to come from save(); the
+     * framing, the shape and the ranks are checked, since merges walk
+     * the right spines on the strength of the ranks.
+     * throw runtime_error if is fails or holds something else; the queue
+     * is then empty if the header was fine, else left as it was.
+     */
+    template<class Stream>
+    void load(Stream& is) {
+      static_assert(std::is_trivially_copyable<T>::value, "snapshots hold raw bytes");
+      snapshot_reader<Stream> r(is, snapshotKind, sizeof(T), recordBytes);
+      clear();
+      size_t cnt = r.header.count;
+      Node* waiting = nullptr;
+      Node** slot = &root;
+      Node* parent = nullptr;  // whose right child goes into slot, if any
+      try {
+        pool.reserve(snapshotReserve(cnt, sizeof(Node)));
+        for (size_t k = 0; k < cnt; ++k) {
+          if (!slot) throw(runtime_error());
+          const char* p = r.get(recordBytes);
+          unsigned long long s = 0;
+          std::memcpy(&s, p, stampBytes);
+          size_t cap = pool.capacity();
+          Node* x = pool.allocate();
+          this->countAlloc(cap, pool.capacity());
+          new (x) Node();
+          std::memcpy(&x->val, p + stampBytes, sizeof(T));
+          x->stamp(s);
+          unsigned char b = p[recordBytes - 1];
+          x->dis = b & 0x7f;
+          // right spines at most maxPath / 2 long, so merges fit in path
+          if (x->dis >= maxPath / 2) throw(runtime_error());
+          if (parent && (x->dis + 1 != parent->dis || parent->lc->dis < x->dis))
+            throw(runtime_error());
+          *slot = x;
+          parent = nullptr;
+          if (b & 0x80) {
+            if (x->dis) {
+              x->rc = waiting;
+              waiting = x;
+            }
+            slot = &x->lc;
+          }
+          else {
+            if (x->dis) throw(runtime_error());
+            slot = nullptr;
+            if (waiting) {
+              parent = waiting;
+              waiting = parent->rc;
+              parent->rc = nullptr;
+              slot = &parent->rc;
+            }
+          }
+        }
+        if (cnt && slot) throw(runtime_error());
+      }
+      catch (...) {
+        // trivially copyable elements need no destructor
+        root = nullptr;
+        pool.clear();
+        throw;
+      }
+      n = cnt;
+      this->setStamps(r.header.stamps);
+    }
+    /**
+     * an element with its stamp, taken out of its node for sorting.
+     */
+    class Item : public NodeStamp<Stable> {
+    public:
+      typedef const Node Source;  // copied out of the nodes
+      T val;
+      template<class V>
+      Item(const Node* x, V&& v) : NodeStamp<Stable>(*x), val(std::forward<V>(v)) {}
+      void putBack() {}
+    };
+    /**
+     * an Item moved out of its node, which it remembers so that it can be
+     * put back.
+     */
+    class Taken : public Item {
+    public:
+      typedef Node Source;
+      Node* from;
+      Taken(Node* x, T&& v) : Item(x, std::move(v)), from(x) {}
+      void putBack() {
+        from->val = std::move(this->val);
+      }
+    };
+    /**
+     * every element of the heap at top in an array, in level order; moved
+     * out of the nodes if N is Node, copied if it is const Node.
+     * the walk keeps the nodes still to visit in a second array instead of
+     * recursing.
+     */
+    template<class N, class I>
+    static void collect(N* top, size_t cnt, heap_array<I>& a) {
+      heap_array<N*> nodes;
+      nodes.reserve(cnt);
+      a.reserve(cnt);
+      if (top) nodes.push_back(top);
+      for (size_t i = 0; i < nodes.size(); ++i) {
+        N* x = nodes[i];
+        if (x->lc) nodes.push_back(x->lc);
+        if (x->rc) nodes.push_back(x->rc);
+        a.emplace_back(x, std::move(x->val));
+      }
+    }
+    /**
+     * heap sort into pop order, top first: a binary heap with the bottom
+     * element at its root hands out the bottom first, which goes to the
+     * back. sorting the elements in one array rather than pointers to the
+     * nodes keeps the comparisons in cache.
+     * compares with below(), so stable mode keeps its order. if Compare
+     * throws, a still holds every element, in some order.
+     */
+    template<class I>
+    void sortItems(heap_array<I>& a) const {
+      size_t len = a.size();
+      unsigned long long cmp = 0;
+      for (size_t i = len / 2; i--;) siftItem(a, i, len, cmp);
+      while (len > 1) {
+        std::swap(a[0], a[--len]);
+        siftItem(a, 0, len, cmp);
+      }
+      this->countCompares(cmp);
+    }
+    template<class I>
+    void siftItem(heap_array<I>& a, size_t i, size_t len, unsigned long long& cmp) const {
+      I x(std::move(a[i]));
+      try {
+        for (size_t c; (c = 2 * i + 1) < len; i = c) {
+          if (c + 1 < len && below(&a[c + 1], &a[c], cmp)) ++c;
+          if (!below(&a[c], &x, cmp)) break;
+          a[i] = std::move(a[c]);
+        }
+      }
+      catch (...) {
+        a[i] = std::move(x);  // fill the hole
+        throw;
+      }
+      a[i] = std::move(x);
+    }
+    /**
+     * append the elements to out in pop order, top first, and leave the
+     * queue empty; O(n log n) without a single pop.
+     * Vector needs push_back, e.g. sjtu::vector.
+     * the elements are moved out of their nodes for the sort, or copied if
+     * that is as cheap; if Compare throws, each goes back into its own
+     * node and the queue is as it was. if out.push_back throws, what has
+     * been appended stays in out and the rest is destroyed with the queue.
+     */
+    template<class Vector>
+    void drain_sorted(Vector& out) {
+      typedef typename std::conditional<std::is_trivially_copyable<T>::value,
+        Item, Taken>::type I;
+      heap_array<I> a;
+      try {
+        collect(static_cast<typename I::Source*>(root), n, a);
+        sortItems(a);
+      }
+      catch (...) {
+        for (size_t i = 0; i < a.size(); ++i) a[i].putBack();
+        throw;
+      }
+      try {
+        for (size_t i = 0; i < a.size(); ++i) out.push_back(std::move(a[i].val));
+      }
+      catch (...) {
+        clear();
+        throw;
+      }
+      clear();
+    }
+    /**
+     * append the elements to out in pop order, top first; the queue is
+     * not touched. if Compare throws, nothing is appended.
+     */
+    template<class Vector>
+    void to_sorted_vector(Vector& out) const {
+      heap_array<Item> a;
+      collect(static_cast<const Node*>(root), n, a);
+      sortItems(a);
+      for (size_t i = 0; i < a.size(); ++i) out.push_back(std::move(a[i].val));
+    }
     /**
      * merge two priority_queues with at least O(logn) complexity.
      * clear the other priority_queue.
+     * in stable mode, ties between the two are broken by their stamps,
+     * which each queue counted on its own.
+     * the nodes of other stay where they are, we just take over its slabs.
+     * both are assumed to order alike; the comparator of this queue is
+     * the one used.
      */
     void merge(priority_queue& other) {
+      if (&other == this) return;
       root = mergeNode(root, other.root);
+      n += other.n;
+      this->joinStamps(other);
       other.root = nullptr;
+      other.n = 0;
+      pool.adopt(other.pool);
+    }
+    /**
+     * merge every queue of [first, last) into this one and clear them.
+     * the heaps meet as a balanced tournament. the merges of one round
+     * are independent, so their compare passes run in lockstep, one node
+     * of every merge per step: the cache misses along the right spines of
+     * the heaps overlap instead of queuing up one merge after another.
+     * if Compare throws, the rounds done so far stay done: every element
+     * is still in exactly one of the queues.
+     */
+    template<class ForwardIterator>
+    void merge_all(ForwardIterator first, ForwardIterator last) {
+      heap_array<priority_queue*> a;
+      a.push_back(this);
+      for (; first != last; ++first)
+        if (&*first != this && !first->empty()) a.push_back(&*first);
+      heap_array<Lane> lanes;
+      heap_array<Node*> paths;
+      for (size_t cnt = a.size(), i; cnt > 1; cnt = i) {
+        mergeRound(a, cnt / 2, lanes, paths);
+        for (i = 0; 2 * i + 1 < cnt; ++i) a[i] = a[2 * i];
+        if (cnt & 1) a[i++] = a[cnt - 1];
+      }
+    }
+  private:
+    struct Lane {
+      Node* x, * y;
+      int len;
+    };
+    /**
+     * one round of merge_all: merge *a[2i + 1] into *a[2i] for every
+     * i < pairs. all comparisons are made before anything is linked, so
+     * if Compare throws, the round changes nothing.
+     */
+    void mergeRound(heap_array<priority_queue*>& a, size_t pairs,
+                    heap_array<Lane>& lanes, heap_array<Node*>& paths) {
+      lanes.clear();
+      for (size_t p = 0; p < pairs; ++p) {
+        Lane l = {a[2 * p]->root, a[2 * p + 1]->root, 0};
+        lanes.push_back(l);
+      }
+      while (paths.size() < pairs * maxPath) paths.push_back(nullptr);
+      unsigned long long cmp = 0;
+      for (size_t busy = pairs; busy;) {
+        busy = 0;
+        for (size_t p = 0; p < pairs; ++p) {
+          Lane& l = lanes[p];
+          if (!l.x || !l.y) continue;
+          if (below(l.x, l.y, cmp)) std::swap(l.x, l.y);
+          paths[p * maxPath + l.len++] = l.x;
+          l.x = l.x->rc;
+          ++busy;
+        }
+      }
+      this->countCompares(cmp);
+      for (size_t p = 0; p < pairs; ++p) {
+        Lane& l = lanes[p];
+        priority_queue& q = *a[2 * p], & other = *a[2 * p + 1];
+        this->countMerge(l.len, 0);
+        q.root = link(&paths[p * maxPath], l.len, l.x ? l.x : l.y);
+        q.n += other.n;
+        q.joinStamps(other);
+        other.root = nullptr;
+        other.n = 0;
+        q.pool.adopt(other.pool);
+      }
+    }
+  };
+
+  /**
+   * node of persistent_priority_queue, shared by every version that
+   * reaches it. once dead, ref is reused to chain it for release.
+   */
+  template<class T>
+  class PersistentNode {
+  public:
+    PersistentNode<T>* lc, * rc;
+    union {
+      size_t ref;
+      PersistentNode<T>* next;
+    };
+    int dis;
+    T val;
+    PersistentNode<T>(const T& e) : lc(nullptr), rc(nullptr), ref(1), dis(0), val(e) {}
+  };
+  /**
+   * an immutable leftist heap: push, pop and merge leave the queue alone
+   * and return a new version, which copies only the O(log n) nodes on the
+   * merge path and shares the rest. copying a version is O(1).
+   * reference counts are plain integers, so versions sharing nodes must
+   * stay on one thread.
+   * every version carries a copy of the Compare of the one it came from;
+   * merge uses the one of the version it is called on.
+   */
+  template<typename T, class Compare = std::less<T>>
+  class persistent_priority_queue : private CompareHolder<Compare> {
+  private:
+    typedef PersistentNode<T> Node;
+    typedef CompareHolder<Compare> Holder;
+    using Holder::comp;
+    /**
+     * right spines of a leftist heap are at most log2(n + 1) long, and
+     * n is kept within a size_t, so a merge path never holds more than
+     * two spines of 64.
+     */
+    static const int maxPath = 128;
+    Node* root;
+    size_t n;
+    /**
+     * a new version of from, holding x.
+     */
+    persistent_priority_queue(const persistent_priority_queue& from, Node* x, size_t cnt) :
+      Holder(from), root(x), n(cnt) {}
+    static int dist(const Node* x) {
+      return x ? x->dis : -1;
+    }
+    static Node* share(Node* x) {
+      if (x) ++x->ref;
+      return x;
+    }
+    /**
+     * drop one reference, and free whatever nobody else sees any more
+     * without recursing.
+     */
+    static void release(Node* x) {
+      if (!x || --x->ref) return;
+      x->next = nullptr;
+      while (x) {
+        Node* dead = x;
+        x = x->next;
+        Node* child[2] = { dead->lc, dead->rc };
+        delete dead;
+        for (int k = 0; k < 2; ++k)
+          if (child[k] && !--child[k]->ref) {
+            child[k]->next = x;
+            x = child[k];
+          }
+      }
+    }
+    /**
+     * merge by path copying. all comparisons are made first, walking the
+     * right spines; the copies are built bottom-up afterwards, so a
+     * throwing Compare costs nothing.
+     * @return a new reference.
+     */
+    Node* mergeNode(Node* x, Node* y) const {
+      Node* path[maxPath];
+      int len = 0;
+      while (x && y) {
+        if (comp()(x->val, y->val)) std::swap(x, y);
+        if (len == maxPath) throw(runtime_error());
+        path[len++] = x;
+        x = x->rc;
+      }
+      Node* cur = share(x ? x : y);
+      try {
+        while (len--) {
+          Node* z = new Node(path[len]->val);
+          z->lc = share(path[len]->lc);
+          z->rc = cur;
+          cur = z;
+          if (dist(z->lc) < dist(z->rc)) std::swap(z->lc, z->rc);
+          z->dis = dist(z->rc) + 1;
+        }
+      }
+      catch (...) {
+        release(cur);
+        throw;
+      }
+      return cur;
+    }
+  public:
+    /**
+     * constructors
+     */
+    persistent_priority_queue() : Holder(Compare()), root(nullptr), n(0) {}
+    explicit persistent_priority_queue(const Compare& c) : Holder(c), root(nullptr), n(0) {}
+    persistent_priority_queue(const persistent_priority_queue& other) :
+      Holder(other), root(share(other.root)), n(other.n) {}
+    /**
+     * deconstructor
+     */
+    ~persistent_priority_queue() {
+      release(root);
+    }
+    /**
+     * Assignment operator
+     */
+    persistent_priority_queue& operator=(const persistent_priority_queue& other) {
+      Holder::operator=(other);
+      share(other.root);
+      release(root);
+      root = other.root; n = other.n;
+      return (*this);
+    }
+    /**
+     * the comparator the queue orders its elements with.
+     */
+    Compare value_comp() const {
+      return comp();
+    }
+    /**
+     * get the top of the queue.
+     * @return a reference of the top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    const T& top() const {
+      if (!root) throw(container_is_empty());
+      return root->val;
+    }
+    /**
+     * @return this version with e added.
+     * throw runtime_error if the size would overflow a size_t.
+     */
+    persistent_priority_queue push(const T& e) const {
+      if (n == size_t(-1)) throw(runtime_error());
+      Node* x = new Node(e);
+      Node* res;
+      try {
+        res = mergeNode(root, x);
+      }
+      catch (...) {
+        delete x;
+        throw;
+      }
+      release(x);
+      return persistent_priority_queue(*this, res, n + 1);
+    }
+    /**
+     * @return this version without its top element.
+     * throw container_is_empty if empty() returns true;
+     */
+    persistent_priority_queue pop() const {
+      if (!root) throw(container_is_empty());
+      return persistent_priority_queue(*this, mergeNode(root->lc, root->rc), n - 1);
+    }
+    /**
+     * @return a version holding the elements of both, in O(log n).
+     * merging a version with itself, or with its own descendants, doubles
+     * the size without copying, so it can outgrow a size_t quickly.
+     * throw runtime_error if the size would overflow a size_t.
+     */
+    persistent_priority_queue merge(const persistent_priority_queue& other) const {
+      if (other.n > size_t(-1) - n) throw(runtime_error());
+      return persistent_priority_queue(*this, mergeNode(root, other.root), n + other.n);
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !root;
     }
   };
 
@@ -0,0 +1,137 @@
+#ifndef SJTU_RADIX_HEAP_HPP
+#define SJTU_RADIX_HEAP_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include "exceptions.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+  /**
+   * a monotone priority queue for unsigned integer keys, smallest first.
+   * keys pushed must not be smaller than floor(), the key last popped or
+   * seen through top(), which is what event simulations and Dijkstra do.
+   * in exchange no key is ever compared against another: an element sits
+   * in the bucket of the highest bit in which its key differs from the
+   * last key, and only moves down, so push is O(1) and pop amortized
+   * O(log C) for keys below C.
+   * every bucket is one contiguous array which keeps its capacity.
+   */
+  template<class Key, class Value>
+  class radix_heap {
+    static_assert(std::is_unsigned<Key>::value, "radix_heap needs unsigned integer keys");
+  public:
+    /**
+     * laid out like sjtu::pair, but moves the value in.
+     */
+    struct value_type {
+      Key first;
+      Value second;
+      template<class V>
+      value_type(Key k, V&& v) : first(k), second(std::forward<V>(v)) {}
+    };
+  private:
+    static const int bits = sizeof(Key) * 8;
+    // top() may have to pull the next bucket down, hence mutable
+    mutable heap_array<value_type> bucket[bits + 1];
+    mutable Key last;
+    size_t n;
+    static int highBit(unsigned long long x) {
+#ifdef __GNUC__
+      return 63 - __builtin_clzll(x);
+#else
+      int r = 0;
+      while (x >>= 1) ++r;
+      return r;
+#endif
+    }
+    int bucketOf(Key k) const {
+      return k == last ? 0 : highBit((unsigned long long)(k ^ last)) + 1;
+    }
+    /**
+     * if bucket 0 ran dry, move last up to the smallest key of the first
+     * non-empty bucket and spread that bucket over the lower ones.
+     */
+    void pull() const {
+      if (!bucket[0].empty()) return;
+      int i = 1;
+      while (bucket[i].empty()) ++i;
+      heap_array<value_type>& b = bucket[i];
+      Key low = b[0].first;
+      for (size_t k = 1; k < b.size(); ++k)
+        if (b[k].first < low) low = b[k].first;
+      last = low;
+      for (size_t k = 0; k < b.size(); ++k) bucket[bucketOf(b[k].first)].push_back(std::move(b[k]));
+      b.clear();
+    }
+  public:
+    /**
+     * constructors
+     */
+    radix_heap() : last(0), n(0) {}
+    /**
+     * get the element with the smallest key.
+     * throw container_is_empty if empty() returns true;
+     */
+    const value_type& top() const {
+      if (!n) throw(container_is_empty());
+      pull();
+      return bucket[0].back();
+    }
+    /**
+     * push new element, O(1).
+     * throw runtime_error if key is smaller than floor().
+     */
+    void push(Key key, const Value& v) {
+      if (key < last) throw(runtime_error());
+      bucket[bucketOf(key)].push_back(value_type(key, v));
+      ++n;
+    }
+    void push(Key key, Value&& v) {
+      if (key < last) throw(runtime_error());
+      bucket[bucketOf(key)].push_back(value_type(key, std::move(v)));
+      ++n;
+    }
+    /**
+     * delete the element with the smallest key.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (!n) throw(container_is_empty());
+      pull();
+      bucket[0].pop_back();
+      --n;
+    }
+    /**
+     * the smallest key that may still be pushed.
+     */
+    Key floor() const {
+      return last;
+    }
+    /**
+     * return the number of the elements.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !n;
+    }
+    /**
+     * drop everything and accept any key again.
+     */
+    void clear() {
+      for (int i = 0; i <= bits; ++i) bucket[i].release();
+      last = 0; n = 0;
+    }
+  };
+
+}
+
+#endif
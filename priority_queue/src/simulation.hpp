@@ -0,0 +1,273 @@
+#ifndef SJTU_SIMULATION_HPP
+#define SJTU_SIMULATION_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include "exceptions.hpp"
+#include "priority_queue.hpp"
+#include "pairing_heap.hpp"
+#include "timer_wheel.hpp"
+
+namespace sjtu {
+
+  /**
+   * what the event queues of event_simulation hold: the time, a sequence
+   * number for ties, and the record of the event with its generation.
+   */
+  struct sim_key {
+    unsigned long long time, seq;
+    size_t slot;
+    unsigned int gen;
+  };
+  /**
+   * earliest time on top, ties in the order scheduled.
+   */
+  struct sim_later {
+    bool operator()(const sim_key& a, const sim_key& b) const {
+      return a.time > b.time || (a.time == b.time && a.seq > b.seq);
+    }
+  };
+
+  /**
+   * event queues for event_simulation: push hands out a handle for erase.
+   * timer_wheel keeps equal times in order by itself, so it never looks
+   * at seq.
+   */
+  class wheel_events {
+  private:
+    timer_wheel<sim_key> q;
+  public:
+    typedef timer_wheel<sim_key>::handle handle;
+    handle push(const sim_key& k) {
+      return q.schedule(k.time, k);
+    }
+    void erase(const handle& h) {
+      q.cancel(h);
+    }
+    const sim_key& top() const {
+      return q.top().second;
+    }
+    void pop() {
+      q.pop();
+    }
+    bool empty() const {
+      return q.empty();
+    }
+  };
+  class pairing_events {
+  private:
+    pairing_heap<sim_key, sim_later> q;
+  public:
+    typedef pairing_heap<sim_key, sim_later>::handle handle;
+    handle push(const sim_key& k) {
+      return q.push(k);
+    }
+    void erase(const handle& h) {
+      q.erase(h);
+    }
+    const sim_key& top() const {
+      return q.top();
+    }
+    void pop() {
+      q.pop();
+    }
+    bool empty() const {
+      return q.empty();
+    }
+  };
+  /**
+   * the leftist priority_queue cannot erase: a cancelled event stays in
+   * the queue until it reaches the top, where its stale generation gets
+   * it skipped.
+   */
+  class leftist_events {
+  private:
+    priority_queue<sim_key, sim_later> q;
+  public:
+    struct handle {};
+    handle push(const sim_key& k) {
+      q.push(k);
+      return handle();
+    }
+    void erase(const handle&) {}
+    const sim_key& top() const {
+      return q.top();
+    }
+    void pop() {
+      q.pop();
+    }
+    bool empty() const {
+      return q.empty();
+    }
+  };
+
+  /**
+   * a discrete-event simulation: callbacks scheduled at integer times
+   * and run in time order, ties in the order they were scheduled.
+   * all events of one time are taken out of the queue as a batch before
+   * the first of them runs; what they schedule for the same time forms
+   * the next batch. a callback may schedule and cancel freely, but must
+   * not call run_until.
+   * Events is wheel_events (default), pairing_events or leftist_events.
+   */
+  template<class Events = wheel_events>
+  class event_simulation {
+  public:
+    typedef unsigned long long tick;
+    typedef std::function<void()> callback;
+    /**
+     * names one scheduled event; goes stale once it has run or been
+     * cancelled, and is then ignored by cancel.
+     */
+    class event_id {
+      friend class event_simulation;
+    private:
+      size_t slot;
+      unsigned int gen;
+      event_id(size_t s, unsigned int g) : slot(s), gen(g) {}
+    public:
+      event_id() : slot((size_t)-1), gen(0) {}
+    };
+  private:
+    /**
+     * records are reused through a free list; gen tells the
+     * incarnations of a slot apart.
+     */
+    struct Record {
+      callback f;
+      typename Events::handle h;
+      unsigned int gen;
+      bool live, queued;
+      Record() : gen(0), live(false), queued(false) {}
+    };
+    Events events;
+    heap_array<Record> records;
+    heap_array<size_t> freeSlots;
+    heap_array<sim_key> batch;
+    size_t batchPos;
+    tick clock;
+    unsigned long long seq;
+    size_t n;
+    bool current(const sim_key& k) const {
+      return records[k.slot].live && records[k.slot].gen == k.gen;
+    }
+    void release(size_t s) {
+      Record& r = records[s];
+      r.f = callback();
+      r.live = r.queued = false;
+      ++r.gen;
+      freeSlots.push_back(s);
+      --n;
+    }
+    /**
+     * run the batch in order from batchPos on. if a callback throws, the
+     * rest of the batch stays where it is, and the next run_until goes on
+     * with it before anything in the queue.
+     */
+    size_t runBatch() {
+      size_t ran = 0;
+      while (batchPos < batch.size()) {
+        const sim_key& k = batch[batchPos++];
+        if (!current(k)) continue;
+        callback f(std::move(records[k.slot].f));
+        release(k.slot);
+        ++ran;
+        f();
+      }
+      batch.clear();
+      batchPos = 0;
+      return ran;
+    }
+  public:
+    /**
+     * constructors
+     * @param start the initial time.
+     */
+    explicit event_simulation(tick start = 0) : batchPos(0), clock(start), seq(0), n(0) {}
+    event_simulation(const event_simulation&) = delete;
+    event_simulation& operator=(const event_simulation&) = delete;
+    /**
+     * make f run at time at.
+     * throw runtime_error if at is before now().
+     */
+    event_id schedule(tick at, callback f) {
+      if (at < clock) throw(runtime_error());
+      if (freeSlots.empty()) {
+        records.push_back(Record());
+        // release() must not fail, so there is room for every slot
+        freeSlots.reserve(records.size());
+        freeSlots.push_back(records.size() - 1);
+      }
+      size_t s = freeSlots.back();
+      Record& r = records[s];
+      sim_key k = { at, seq, s, r.gen };
+      r.h = events.push(k);
+      freeSlots.pop_back();
+      ++seq;
+      r.f = std::move(f);
+      r.live = r.queued = true;
+      ++n;
+      return event_id(s, k.gen);
+    }
+    /**
+     * drop a pending event.
+     * @return false if it has already run or been cancelled.
+     */
+    bool cancel(const event_id& id) {
+      if (id.slot >= records.size()) return false;
+      Record& r = records[id.slot];
+      if (!r.live || r.gen != id.gen) return false;
+      if (r.queued) events.erase(r.h);
+      release(id.slot);
+      return true;
+    }
+    /**
+     * run every event due by t, batch after batch, and move the clock to
+     * t; the clock stands at the time of the batch while it runs.
+     * @return the number of callbacks run.
+     */
+    size_t run_until(tick t) {
+      size_t ran = 0;
+      if (!batch.empty() && clock <= t) ran += runBatch();
+      for (;;) {
+        while (!events.empty() && !current(events.top())) events.pop();
+        if (events.empty() || events.top().time > t) break;
+        clock = events.top().time;
+        while (!events.empty() && events.top().time == clock) {
+          const sim_key& k = events.top();
+          if (current(k)) {
+            batch.push_back(k);
+            records[k.slot].queued = false;
+          }
+          events.pop();
+        }
+        ran += runBatch();
+      }
+      if (t > clock) clock = t;
+      return ran;
+    }
+    /**
+     * the current time; no event may be scheduled before it.
+     */
+    tick now() const {
+      return clock;
+    }
+    /**
+     * return the number of pending events.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !n;
+    }
+  };
+
+}
+
+#endif
@@ -0,0 +1,360 @@
+#ifndef SJTU_TIMER_WHEEL_HPP
+#define SJTU_TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "exceptions.hpp"
+#include "priority_queue.hpp"
+
+namespace sjtu {
+
+  /**
+   * a hierarchical timing wheel for timeouts, earliest deadline first.
+   * there are 11 levels of 64 slots; a timer sits on the level of the
+   * highest 6-bit digit in which its deadline differs from an internal
+   * base, in the slot of that digit. the base never passes a pending
+   * deadline, but may run ahead of now(): top() moves it to the first
+   * nonempty slot, which sends that slot down a level, until the next
+   * timer is on level 0. schedule and cancel are O(1) list operations.
+   * moving the base only sends timers down a level, at most 10 times
+   * each, so top and firing are amortized O(1) as well, and no two
+   * deadlines are ever compared. scheduling before the base moves it
+   * back and takes the timers it passed up to one level again.
+   * timers with equal deadlines fire in the order they were scheduled.
+   * top/pop/push/size/empty work like priority_queue, with pop moving the
+   * clock to the deadline it fires. schedule hands out a handle which
+   * stays valid until its timer fires or is cancelled.
+   */
+  template<class Value>
+  class timer_wheel {
+  public:
+    typedef unsigned long long tick;
+    /**
+     * laid out like sjtu::pair: the deadline and the payload.
+     */
+    struct value_type {
+      tick first;
+      Value second;
+      template<class V>
+      value_type(tick t, V&& v) : first(t), second(std::forward<V>(v)) {}
+    };
+  private:
+    static const int slotBits = 6, slots = 1 << slotBits;
+    static const int levels = (64 + slotBits - 1) / slotBits;
+    /**
+     * every slot is a circular list: head->prev is the tail.
+     */
+    struct Node {
+      Node* prev, * next;
+      value_type val;
+      template<class V>
+      Node(tick t, V&& v) : prev(nullptr), next(nullptr), val(t, std::forward<V>(v)) {}
+    };
+  public:
+    /**
+     * refers to one pending timer.
+     */
+    class handle {
+      friend class timer_wheel;
+    private:
+      Node* p;
+      handle(Node* x) : p(x) {}
+    public:
+      handle() : p(nullptr) {}
+      const value_type& operator*() const {
+        return p->val;
+      }
+      const value_type* operator->() const {
+        return &p->val;
+      }
+      bool operator==(const handle& rhs) const {
+        return p == rhs.p;
+      }
+      bool operator!=(const handle& rhs) const {
+        return p != rhs.p;
+      }
+    };
+  private:
+    // top() may move the base and the timers with it
+    mutable Node* head[levels][slots];
+    mutable unsigned long long used[levels];  // bit s set iff slot s is not empty
+    mutable tick base;
+    tick clock;
+    size_t n;
+    // the earliest timer, found by top() and kept until it may change
+    mutable Node* best;
+    node_pool<Node> pool;
+    static int lowBit(unsigned long long x) {
+#ifdef __GNUC__
+      return __builtin_ctzll(x);
+#else
+      int r = 0;
+      while (!(x & 1)) x >>= 1, ++r;
+      return r;
+#endif
+    }
+    static int highBit(unsigned long long x) {
+#ifdef __GNUC__
+      return 63 - __builtin_clzll(x);
+#else
+      int r = 0;
+      while (x >>= 1) ++r;
+      return r;
+#endif
+    }
+    static int digit(tick t, int level) {
+      return (int)(t >> (level * slotBits)) & (slots - 1);
+    }
+    int levelOf(tick t) const {
+      return t == base ? 0 : highBit(t ^ base) / slotBits;
+    }
+    void link(Node* x) const {
+      int l = levelOf(x->val.first), s = digit(x->val.first, l);
+      Node*& h = head[l][s];
+      if (!h) {
+        h = x->prev = x->next = x;
+        used[l] |= 1ull << s;
+        return;
+      }
+      x->prev = h->prev; x->next = h;
+      h->prev->next = x; h->prev = x;
+    }
+    void unlink(Node* x) {
+      int l = levelOf(x->val.first), s = digit(x->val.first, l);
+      Node*& h = head[l][s];
+      if (x->next == x) {
+        h = nullptr;
+        used[l] &= ~(1ull << s);
+        return;
+      }
+      x->prev->next = x->next; x->next->prev = x->prev;
+      if (h == x) h = x->next;
+    }
+    /**
+     * take a whole slot out and link its timers again, in order.
+     */
+    void relink(int l, int s) const {
+      Node* x = head[l][s];
+      head[l][s] = nullptr;
+      used[l] &= ~(1ull << s);
+      x->prev->next = nullptr;
+      while (x) {
+        Node* next = x->next;
+        link(x);
+        x = next;
+      }
+    }
+    /**
+     * move the base forward to t, no later than any pending deadline.
+     * a timer has to move only if t now shares its digit on its level,
+     * which is one slot per level; it lands on a lower level, never in
+     * a slot still to be looked at.
+     */
+    void raiseBase(tick t) const {
+      base = t;
+      for (int l = levels - 1; l > 0; --l)
+        if (used[l] >> digit(t, l) & 1) relink(l, digit(t, l));
+    }
+    /**
+     * move the base back to t, before every pending deadline. only the
+     * timers below the highest digit in which t differs from the base
+     * change their place: all of them go up to that level.
+     */
+    void lowerBase(tick t) {
+      int top = highBit(t ^ base) / slotBits;
+      Node* all = nullptr;
+      for (int l = 0; l <= top; ++l) {
+        for (; used[l]; used[l] &= used[l] - 1) {
+          Node*& h = head[l][lowBit(used[l])];
+          h->prev->next = all;
+          all = h;
+          h = nullptr;
+        }
+      }
+      base = t;
+      while (all) {
+        Node* next = all->next;
+        link(all);
+        all = next;
+      }
+    }
+    /**
+     * move the clock to t, no later than any pending deadline.
+     */
+    void setClock(tick t) {
+      clock = t;
+      if (t > base) raiseBase(t);
+    }
+    /**
+     * the earliest timer: the lowest level holds the earliest deadlines
+     * and its lowest slot the earliest of those. while that slot is above
+     * level 0, the base moves to its start and sends it down; on level 0
+     * the deadlines of a slot are all equal and its head came first.
+     */
+    Node* earliest() const {
+      if (best) return best;
+      for (;;) {
+        int l = 0;
+        while (!used[l]) ++l;
+        if (!l) break;
+        // keep the digits above l, take the slot as digit l, zeros below
+        tick below = (1ull << l * slotBits) - 1;
+        tick mask = below | (tick)(slots - 1) << l * slotBits;
+        raiseBase((base & ~mask) | (tick)lowBit(used[l]) << l * slotBits);
+      }
+      return best = head[0][lowBit(used[0])];
+    }
+    template<class V>
+    handle scheduleValue(tick deadline, V&& v) {
+      if (deadline < clock) throw(runtime_error());
+      Node* x = pool.allocate();
+      try {
+        new (x) Node(deadline, std::forward<V>(v));
+      }
+      catch (...) {
+        pool.deallocate(x);
+        throw;
+      }
+      if (deadline < base) lowerBase(deadline);
+      link(x);
+      if (best && deadline < best->val.first) best = x;
+      ++n;
+      return handle(x);
+    }
+    void release(Node* x) {
+      unlink(x);
+      if (x == best) best = nullptr;
+      x->~Node();
+      pool.deallocate(x);
+      --n;
+    }
+  public:
+    /**
+     * constructors
+     * @param start the initial clock.
+     */
+    explicit timer_wheel(tick start = 0) : base(start), clock(start), n(0), best(nullptr) {
+      for (int l = 0; l < levels; ++l) {
+        used[l] = 0;
+        for (int s = 0; s < slots; ++s) head[l][s] = nullptr;
+      }
+    }
+    timer_wheel(const timer_wheel&) = delete;
+    timer_wheel& operator=(const timer_wheel&) = delete;
+    /**
+     * deconstructor
+     */
+    ~timer_wheel() {
+      clear();
+    }
+    /**
+     * arm a timer in O(1).
+     * throw runtime_error if deadline is before now().
+     * @return a handle to cancel it with.
+     */
+    handle schedule(tick deadline, const Value& v) {
+      return scheduleValue(deadline, v);
+    }
+    handle schedule(tick deadline, Value&& v) {
+      return scheduleValue(deadline, std::move(v));
+    }
+    handle push(tick deadline, const Value& v) {
+      return scheduleValue(deadline, v);
+    }
+    handle push(tick deadline, Value&& v) {
+      return scheduleValue(deadline, std::move(v));
+    }
+    /**
+     * disarm a pending timer in O(1); h becomes invalid.
+     * throw invalid_iterator if h refers to nothing.
+     */
+    void cancel(const handle& h) {
+      if (!h.p) throw(invalid_iterator());
+      release(h.p);
+    }
+    /**
+     * get the timer with the earliest deadline; the clock does not move.
+     * throw container_is_empty if empty() returns true;
+     */
+    const value_type& top() const {
+      if (!n) throw(container_is_empty());
+      return earliest()->val;
+    }
+    /**
+     * fire the earliest timer: drop it and move the clock to its deadline.
+     * throw container_is_empty if empty() returns true;
+     */
+    void pop() {
+      if (!n) throw(container_is_empty());
+      Node* x = earliest();
+      tick t = x->val.first;
+      release(x);
+      setClock(t);
+    }
+    /**
+     * fire every timer due by t, earliest first, calling fire(value_type&)
+     * on each after it has left the wheel, then move the clock to t.
+     * fire may schedule and cancel other timers.
+     * @return the number of timers fired.
+     */
+    template<class F>
+    size_t advance(tick t, F fire) {
+      size_t fired = 0;
+      while (n && earliest()->val.first <= t) {
+        Node* x = earliest();
+        tick due = x->val.first;
+        value_type e(std::move(x->val));
+        release(x);
+        setClock(due);
+        ++fired;
+        fire(e);
+      }
+      if (t > clock) setClock(t);
+      return fired;
+    }
+    /**
+     * the current time; no deadline may be earlier.
+     */
+    tick now() const {
+      return clock;
+    }
+    /**
+     * return the number of pending timers.
+     */
+    size_t size() const {
+      return n;
+    }
+    /**
+     * check if the container has at least an element.
+     * @return true if it is empty, false if it has at least an element.
+     */
+    bool empty() const {
+      return !n;
+    }
+    /**
+     * drop every timer; the clock stays where it is.
+     */
+    void clear() {
+      for (int l = 0; l < levels; ++l) {
+        for (; used[l]; used[l] &= used[l] - 1) {
+          Node*& h = head[l][lowBit(used[l])];
+          h->prev->next = nullptr;
+          for (Node* x = h; x;) {
+            Node* next = x->next;
+            x->~Node();
+            x = next;
+          }
+          h = nullptr;
+        }
+      }
+      pool.clear();
+      best = nullptr;
+      base = clock;
+      n = 0;
+    }
+  };
+
+}
+
+#endif